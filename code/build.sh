@@ -1,3 +1,8 @@
-clang code/main.c -o ../build/nyt
-clang code/nyt_asset_packer.c -o ../build/nyt_asset_packer
-../build/nyt_asset_packer ../build/nyt docs/scrabble.txt
+clang code/main.c -pthread -o ../build/nyt
+clang code/nyt_asset_packer.c -pthread -o ../build/nyt_asset_packer
+../build/nyt_asset_packer ../build/nyt docs/scrabble.txt docs/scrabble.lex
+clang -O2 -DNYT_PROFILE=1 code/main.c -pthread -o ../build/nyt_profile
+../build/nyt_asset_packer ../build/nyt_profile docs/scrabble.txt docs/scrabble.lex
+clang -O2 code/nyt_bench.c -pthread -o ../build/nyt_bench
+clang --target=wasm32 -msimd128 -mbulk-memory -O2 -nostdlib -Wl,--no-entry -Wl,--export-all -Wl,--import-memory code/nyt.c -o docs/bee.wasm
+clang --target=wasm32 -msimd128 -mbulk-memory -matomics -mmutable-globals -O2 -nostdlib -Wl,--no-entry -Wl,--export-all -Wl,--export=__stack_pointer -Wl,--import-memory -Wl,--shared-memory -Wl,--max-memory=134217728 code/nyt.c -o docs/nyt_threads.wasm
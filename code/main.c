@@ -1,34 +1,428 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "nyt.c"
+#include "nyt_posix.c"
+#include "nyt_output.c"
 
-static inline void PrintArenaStats(struct memory_arena Arena)
+static struct packed_assets_header *MapPackedAssets(char *ExecutablePath)
 {
-    printf("%zu / %zu (%f)\n", Arena.Allocated, Arena.Size, (float)Arena.Allocated / (float)Arena.Size);
+    struct packed_assets_header *Result = 0;
+    int ExecutableFile = open(ExecutablePath, O_RDONLY);
+    if (ExecutableFile < 0)
+    {
+        printf("Failed to open executable %s\n", ExecutablePath);
+        return 0;
+    }
+    struct stat Stat;
+    size_t DataStart;
+    if (0 == fstat(ExecutableFile, &Stat) && sizeof(size_t) <= (size_t)Stat.st_size &&
+        sizeof(DataStart) == pread(ExecutableFile, &DataStart, sizeof(DataStart), Stat.st_size - sizeof(size_t)) &&
+        DataStart < (size_t)Stat.st_size - sizeof(size_t))
+    {
+        size_t DataEnd = Stat.st_size - sizeof(size_t);
+        size_t MapStart = DataStart & ~((size_t)sysconf(_SC_PAGESIZE) - 1);
+        size_t MapSize = DataEnd - MapStart;
+        char *Map = mmap(0, MapSize, PROT_READ, MAP_PRIVATE, ExecutableFile, MapStart);
+        if (Map != MAP_FAILED)
+        {
+            struct packed_assets_header *Header = (struct packed_assets_header *)(Map + (DataStart - MapStart));
+            if (DataStart + sizeof(*Header) <= DataEnd &&
+                Header->Magic == PACKED_ASSETS_MAGIC &&
+                Header->Version == PACKED_ASSETS_VERSION)
+            {
+                Result = Header;
+                for (int AssetIndex = 0; AssetIndex < packed_asset_Count; ++AssetIndex)
+                {
+                    struct packed_asset Asset = Header->Assets[AssetIndex];
+                    if (DataEnd - DataStart < Asset.Offset + Asset.Size)
+                    {
+                        Result = 0;
+                    }
+                }
+            }
+            if (!Result)
+            {
+                munmap(Map, MapSize);
+            }
+        }
+    }
+    close(ExecutableFile);
+    if (!Result)
+    {
+        printf("No packed assets found in %s (was it run through nyt_asset_packer?)\n", ExecutablePath);
+    }
+    return Result;
 }
 
-static char *ReadLexicon(char *ExecutablePath)
+static inline void *GetPackedAsset(struct packed_assets_header *Assets, enum packed_asset_type Type)
 {
-    FILE *ExecutableFile = fopen(ExecutablePath, "rb");
-    if (!ExecutableFile)
+    return (char *)Assets + Assets->Assets[Type].Offset;
+}
+
+static int ParseDictionaryKind(char *Name, enum dictionary_kind *Kind)
+{
+    int Result = 1;
+    if (Name && 0 == strcmp(Name, "trie"))
     {
-        printf("Failed to open executable %s\n", ExecutablePath);
+        *Kind = dictionary_kind_Trie;
     }
-    size_t DataStart;
-    fseek(ExecutableFile, -sizeof(size_t), SEEK_END);
-    size_t DataEnd = ftell(ExecutableFile);
-    fread(&DataStart, sizeof(DataStart), 1, ExecutableFile);
-    fseek(ExecutableFile, DataStart, SEEK_SET);
-    size_t LexiconMemorySize = DataEnd - DataStart;
-    char *LexiconMemory = malloc(LexiconMemorySize + 1);
-    fread(LexiconMemory, 1, LexiconMemorySize, ExecutableFile);
-    LexiconMemory[LexiconMemorySize - 1] = 0;
-    return LexiconMemory;
+    else if (Name && 0 == strcmp(Name, "dawg"))
+    {
+        *Kind = dictionary_kind_Dawg;
+    }
+    else
+    {
+        printf("Unrecognized dictionary %s\nValid dictionaries are: trie, dawg\n", Name ? Name : "(none)");
+        Result = 0;
+    }
+    return Result;
+}
+
+static int ParseBeeDictionaryKind(char *Name, enum dictionary_kind *Kind, char *UseIndex)
+{
+    *UseIndex = Name && 0 == strcmp(Name, "index");
+    return *UseIndex || ParseDictionaryKind(Name, Kind);
+}
+
+static struct bee_index LoadBeeIndex(struct memory_arena *Arena, struct packed_assets_header *Assets)
+{
+    struct bee_index Result = LoadBeeIndexImage(GetPackedAsset(Assets, packed_asset_BeeIndexImage), Assets->Assets[packed_asset_BeeIndexImage].Size);
+    if (!Result.Slots)
+    {
+        Result = BuildBeeIndex(Arena, GetPackedAsset(Assets, packed_asset_Lexicon), Assets->Assets[packed_asset_Lexicon].Size);
+    }
+    return Result;
+}
+
+static int WriteBeePuzzleTable(struct memory_arena *Arena, struct packed_assets_header *Assets, char *Path)
+{
+    struct bee_puzzle_table Table = BuildBeePuzzleTable(Arena, GetPackedAsset(Assets, packed_asset_Lexicon), Assets->Assets[packed_asset_Lexicon].Size);
+    size_t ImageSize = BeePuzzleTableImageSize(&Table);
+    char *Image = PushArray(Arena, ImageSize, char);
+    WriteBeePuzzleTableImage(&Table, Image);
+    FILE *TableFile = fopen(Path, "wb");
+    if (!TableFile)
+    {
+        printf("Failed to open %s\n", Path);
+        return 0;
+    }
+    fwrite(Image, 1, ImageSize, TableFile);
+    fclose(TableFile);
+    printf("Wrote %u banks from %u bee words (%zu bytes) to %s\n", Table.BankCount, Table.WordCount, ImageSize, Path);
+    return 1;
+}
+
+static struct bee_puzzle_table MapBeePuzzleTable(char *Path)
+{
+    struct bee_puzzle_table Result = {0};
+    int TableFile = open(Path, O_RDONLY);
+    struct stat Stat;
+    if (0 <= TableFile && 0 == fstat(TableFile, &Stat) && Stat.st_size)
+    {
+        char *Map = mmap(0, Stat.st_size, PROT_READ, MAP_PRIVATE, TableFile, 0);
+        if (Map != MAP_FAILED)
+        {
+            Result = LoadBeePuzzleTableImage(Map, Stat.st_size);
+            if (!Result.Entries)
+            {
+                munmap(Map, Stat.st_size);
+            }
+        }
+    }
+    if (0 <= TableFile)
+    {
+        close(TableFile);
+    }
+    if (!Result.Entries)
+    {
+        printf("No bee puzzle table found in %s (was it written with --write-table?)\n", Path);
+    }
+    return Result;
+}
+
+static struct dictionary LoadDictionary_(struct memory_arena *Arena, struct packed_assets_header *Assets, enum dictionary_kind Kind)
+{
+    struct dictionary Result = {0};
+    if (Kind == dictionary_kind_Dawg)
+    {
+        Result = DawgDictionary(LoadDawgImage(GetPackedAsset(Assets, packed_asset_DawgImage), Assets->Assets[packed_asset_DawgImage].Size));
+        if (Result.Dawg.NodeCount)
+        {
+            return Result;
+        }
+    }
+
+    struct trie_builder Builder = BuildTrieParallel(Arena, GetPackedAsset(Assets, packed_asset_Lexicon), Assets->Assets[packed_asset_Lexicon].Size, 0);
+    if (Kind == dictionary_kind_Dawg)
+    {
+        Result = DawgDictionary(BuildDawgFromTrie(Arena, Builder.Root, Builder.NodeCount));
+    }
+    else
+    {
+        size_t TrieSize = TrieImageSize(&Builder);
+        char *TrieImage = PushArray(Arena, TrieSize, char);
+        WriteTrieImage(&Builder, TrieImage);
+        Result = TrieImageDictionary(LoadTrieImage(TrieImage, TrieSize));
+    }
+    return Result;
+}
+
+static struct dictionary LoadDictionary(struct memory_arena *Arena, struct packed_assets_header *Assets, enum dictionary_kind Kind)
+{
+    PROFILE_BLOCK_BEGIN(LoadDictionary);
+    struct dictionary Result = LoadDictionary_(Arena, Assets, Kind);
+    PROFILE_BLOCK_END(LoadDictionary);
+    return Result;
+}
+
+enum profile_output
+{
+    profile_output_None,
+    profile_output_Table,
+    profile_output_Json,
+};
+
+static int CheckProfileOutput(enum profile_output Output)
+{
+    int Result = NYT_PROFILE || Output == profile_output_None;
+    if (!Result)
+    {
+        printf("Profiling is compiled out; rebuild with -DNYT_PROFILE=1 to use --profile\n");
+    }
+    return Result;
+}
+
+#if NYT_PROFILE
+
+static uint64_t ProfileStartNanoseconds;
+static uint64_t ProfileStartCycles;
+
+static void StartProfile(void)
+{
+    ProfileStartNanoseconds = GetNanoseconds();
+    ProfileStartCycles = ReadCycleCounter();
+}
+
+static void ReportProfile(enum profile_output Output)
+{
+    if (Output != profile_output_None)
+    {
+        FlushProfile();
+        PrintProfile(Output == profile_output_Json, GetNanoseconds() - ProfileStartNanoseconds, ReadCycleCounter() - ProfileStartCycles);
+    }
+}
+
+#else
+
+#define StartProfile()
+#define ReportProfile(Output)
+
+#endif
+
+struct strands_worker
+{
+    pthread_t Thread;
+    int WorkerIndex;
+    struct strands_job *Job;
+    struct solution_builder Builder;
+};
+
+static void *StrandsWorkerProc(void *Parameter)
+{
+    struct strands_worker *Worker = (struct strands_worker *)Parameter;
+    RunStrandsJob(Worker->Job, Worker->WorkerIndex, &Worker->Builder);
+    return 0;
+}
+
+static void SolveStrands(struct memory_arena *Arena, struct dictionary *Dictionary, struct strands_puzzle *Puzzle, struct solution_builder *SolutionBuilder, int ThreadCount)
+{
+    if (ThreadCount <= 1)
+    {
+        for (int CellIndex = 0; CellIndex < Puzzle->CellCount; ++CellIndex)
+        {
+            SolveStrandsCell(Puzzle, CellIndex, Dictionary, SolutionBuilder);
+        }
+    }
+    else
+    {
+        struct strands_job Job = {0};
+        Job.Puzzle = Puzzle;
+        Job.Dictionary = Dictionary;
+        struct strands_worker *Workers = (struct strands_worker *)ArenaPush(Arena, ThreadCount*sizeof(struct strands_worker));
+        for (int WorkerIndex = 0; WorkerIndex < ThreadCount; ++WorkerIndex)
+        {
+            struct strands_worker *Worker = Workers + WorkerIndex;
+            memset(Worker, 0, sizeof(*Worker));
+            Worker->WorkerIndex = WorkerIndex;
+            Worker->Job = &Job;
+            Worker->Builder.StringArena = ReserveArena(SolutionBuilder->StringArena.Reserved, "worker strings");
+            Worker->Builder.SolutionArena = ReserveArena(SolutionBuilder->SolutionArena.Reserved, "worker solutions");
+            pthread_create(&Worker->Thread, 0, StrandsWorkerProc, Worker);
+        }
+        for (int WorkerIndex = 0; WorkerIndex < ThreadCount; ++WorkerIndex)
+        {
+            pthread_join(Workers[WorkerIndex].Thread, 0);
+        }
+
+        struct solution **WorkerSolutions = PushArray(Arena, ThreadCount, struct solution *);
+        for (int WorkerIndex = 0; WorkerIndex < ThreadCount; ++WorkerIndex)
+        {
+            WorkerSolutions[WorkerIndex] = (struct solution *)Workers[WorkerIndex].Builder.SolutionArena.Memory;
+        }
+        GatherStrandsJob(&Job, WorkerSolutions, SolutionBuilder);
+        for (int WorkerIndex = 0; WorkerIndex < ThreadCount; ++WorkerIndex)
+        {
+            ReleaseArena(&Workers[WorkerIndex].Builder.SolutionArena);
+        }
+    }
+    DeduplicateSolutions(Puzzle, SolutionBuilder, Arena);
+}
+
+struct best_combination
+{
+    int Most;
+    struct combination Combination;
+};
+
+static void PrintCombination(void *Context, struct solution *Solutions, int *Indices, int Count)
+{
+    struct best_combination *Best = (struct best_combination *)Context;
+    int Test = 0;
+    for (int IndexIndex = 0; IndexIndex < Count; ++IndexIndex)
+    {
+        Test += Solutions[Indices[IndexIndex]].Length;
+    }
+    OutputCombination(&Output, Solutions, Indices, Count);
+    if (Best && Best->Most < Test)
+    {
+        Best->Most = Test;
+        Best->Combination.Count = Count;
+        Copy(Best->Combination.Indices, Indices, Count*sizeof(int));
+    }
+}
+
+static int ParseCombineMode(char *Name, enum combine_mode *Mode)
+{
+    int Result = 1;
+    if (Name && 0 == strcmp(Name, "all"))
+    {
+        *Mode = combine_mode_All;
+    }
+    else if (Name && 0 == strcmp(Name, "maximal"))
+    {
+        *Mode = combine_mode_Maximal;
+    }
+    else if (Name && 0 == strcmp(Name, "full"))
+    {
+        *Mode = combine_mode_Full;
+    }
+    else
+    {
+        printf("Unrecognized combination mode %s\nValid modes are: all, maximal, full\n", Name ? Name : "(none)");
+        Result = 0;
+    }
+    return Result;
 }
 
+static int ParseOutputFormat(char *Name, enum output_format *Format)
+{
+    int Result = 1;
+    if (Name && 0 == strcmp(Name, "text"))
+    {
+        *Format = output_format_Text;
+    }
+    else if (Name && 0 == strcmp(Name, "ndjson"))
+    {
+        *Format = output_format_Ndjson;
+    }
+    else if (Name && 0 == strcmp(Name, "binary"))
+    {
+        *Format = output_format_Binary;
+    }
+    else
+    {
+        printf("Unrecognized output format %s\nValid formats are: text, ndjson, binary\n", Name ? Name : "(none)");
+        Result = 0;
+    }
+    return Result;
+}
+
+static int ParseUnknownCells(char *Name, enum unknown_cells *Unknown)
+{
+    int Result = 1;
+    if (Name && 0 == strcmp(Name, "literal"))
+    {
+        *Unknown = unknown_cells_Literal;
+    }
+    else if (Name && 0 == strcmp(Name, "blocked"))
+    {
+        *Unknown = unknown_cells_Blocked;
+    }
+    else if (Name && 0 == strcmp(Name, "wildcard"))
+    {
+        *Unknown = unknown_cells_Wildcard;
+    }
+    else
+    {
+        printf("Unrecognized unknown cell mode %s\nValid modes are: literal, blocked, wildcard\n", Name ? Name : "(none)");
+        Result = 0;
+    }
+    return Result;
+}
+
+static int ParseWildcardCount(char *Value, int *MaxWildcards)
+{
+    int Result = 0;
+    if (Value)
+    {
+        char *End;
+        long Count = strtol(Value, &End, 10);
+        if (*Value && !*End && 0 <= Count && Count <= 8)
+        {
+            *MaxWildcards = (int)Count;
+            Result = 1;
+        }
+    }
+    if (!Result)
+    {
+        printf("Expected a wildcard count between 0 and 8, got %s\n", Value ? Value : "(none)");
+    }
+    return Result;
+}
+
+static int ParseThreadCount(char *Value, int *ThreadCount)
+{
+    int Result = 0;
+    if (Value)
+    {
+        char *End;
+        long Count = strtol(Value, &End, 10);
+        if (*Value && !*End && 0 <= Count && Count <= 1024)
+        {
+            *ThreadCount = Count ? (int)Count : (int)sysconf(_SC_NPROCESSORS_ONLN);
+            Result = 1;
+        }
+    }
+    if (!Result)
+    {
+        printf("Expected a thread count between 0 and 1024 (0 uses every core), got %s\n", Value ? Value : "(none)");
+    }
+    return Result;
+}
+
+#include "nyt_cache.c"
+#include "nyt_batch.c"
+#include "nyt_server.c"
+
 int main(int ArgCount, char *Args[])
 {
+    StartProfile();
     char *ExecutableName, *ExecutablePath;
     ExecutableName = ExecutablePath = Args[0];
     for (char *At = ExecutablePath; *At; At++)
@@ -40,139 +434,230 @@ int main(int ArgCount, char *Args[])
     }
     if (ArgCount < 2)
     {
-        printf("usage: %s strands|bee <param>\n", ExecutableName);
+        printf("usage: %s strands|bee|batch|serve <param>\n", ExecutableName);
         return 1;
     }
 
-    struct memory_arena Arena = {0};
-    Arena.Size = 1024*1024*1024;
-    Arena.Memory = malloc(Arena.Size);
+    struct packed_assets_header *Assets = MapPackedAssets(ExecutablePath);
+    if (!Assets)
+    {
+        return 1;
+    }
+
+    struct memory_arena Arena = ReserveArena(4ull*1024*1024*1024, "main");
 
     char *GameName = Args[1];
-    if (0 == strcmp(GameName, "strands"))
+    if (0 == strcmp(GameName, "batch"))
     {
-        if (ArgCount < 3)
+        return RunBatch(&Arena, Assets, ExecutableName, ArgCount, Args);
+    }
+    else if (0 == strcmp(GameName, "serve"))
+    {
+        return RunServer(&Arena, Assets, ExecutableName, ArgCount, Args);
+    }
+    else if (0 == strcmp(GameName, "strands"))
+    {
+        char *Filename = 0;
+        int ThreadCount = 1;
+        char ExactCoverOnly = 0;
+        char BestOnly = 0;
+        char RequireSpangram = 0;
+        enum combine_mode CombineMode = combine_mode_All;
+        enum unknown_cells Unknown = unknown_cells_Literal;
+        enum profile_output ProfileOutput = profile_output_None;
+        enum output_format OutputFormat = output_format_Text;
+        char SummaryOnly = 0;
+        int MaxWildcards = DEFAULT_MAX_WILDCARDS;
+        enum dictionary_kind DictionaryKind = dictionary_kind_Dawg;
+        for (int ArgIndex = 2; ArgIndex < ArgCount; ++ArgIndex)
         {
-            printf("usage: %s %s <filename>\n", ExecutableName, GameName);
+            char *Arg = Args[ArgIndex];
+            if ('-' == *Arg)
+            {
+                if (0 == strcmp("-d", Arg) || 0 == strcmp("--dictionary", Arg))
+                {
+                    if (!ParseDictionaryKind(++ArgIndex < ArgCount ? Args[ArgIndex] : 0, &DictionaryKind))
+                    {
+                        return 1;
+                    }
+                }
+                else if (0 == strcmp("-j", Arg) || 0 == strcmp("--jobs", Arg))
+                {
+                    if (!ParseThreadCount(++ArgIndex < ArgCount ? Args[ArgIndex] : 0, &ThreadCount))
+                    {
+                        return 1;
+                    }
+                }
+                else if (0 == strcmp("-x", Arg) || 0 == strcmp("--exact", Arg))
+                {
+                    ExactCoverOnly = 1;
+                }
+                else if (0 == strcmp("-b", Arg) || 0 == strcmp("--best", Arg))
+                {
+                    BestOnly = 1;
+                }
+                else if (0 == strcmp("-s", Arg) || 0 == strcmp("--spangram", Arg))
+                {
+                    ExactCoverOnly = 1;
+                    RequireSpangram = 1;
+                }
+                else if (0 == strcmp("-m", Arg) || 0 == strcmp("--combinations", Arg))
+                {
+                    if (!ParseCombineMode(++ArgIndex < ArgCount ? Args[ArgIndex] : 0, &CombineMode))
+                    {
+                        return 1;
+                    }
+                }
+                else if (0 == strcmp("-u", Arg) || 0 == strcmp("--unknown", Arg))
+                {
+                    if (!ParseUnknownCells(++ArgIndex < ArgCount ? Args[ArgIndex] : 0, &Unknown))
+                    {
+                        return 1;
+                    }
+                }
+                else if (0 == strcmp("-w", Arg) || 0 == strcmp("--wildcards", Arg))
+                {
+                    Unknown = unknown_cells_Wildcard;
+                    if (!ParseWildcardCount(++ArgIndex < ArgCount ? Args[ArgIndex] : 0, &MaxWildcards))
+                    {
+                        return 1;
+                    }
+                }
+                else if (0 == strcmp("-o", Arg) || 0 == strcmp("--output", Arg))
+                {
+                    if (!ParseOutputFormat(++ArgIndex < ArgCount ? Args[ArgIndex] : 0, &OutputFormat))
+                    {
+                        return 1;
+                    }
+                }
+                else if (0 == strcmp("--summary", Arg))
+                {
+                    SummaryOnly = 1;
+                }
+                else if (0 == strcmp("--profile", Arg))
+                {
+                    ProfileOutput = profile_output_Table;
+                }
+                else if (0 == strcmp("--profile-json", Arg))
+                {
+                    ProfileOutput = profile_output_Json;
+                }
+                else
+                {
+                    printf("Unrecognized option %s\nValid options are: -d, -j, -x, -b, -s, -m, -u, -w, -o, --summary, --profile, --profile-json\n", Arg);
+                    return 1;
+                }
+            }
+            else
+            {
+                Filename = Arg;
+            }
+        }
+        if (!Filename)
+        {
+            printf("usage: %s %s [-d trie|dawg] [-j N] [-x] [-b] [-s] [-m all|maximal|full] [-u literal|blocked|wildcard] [-w N] [-o text|ndjson|binary] [--summary] [--profile|--profile-json] <filename>\n", ExecutableName, GameName);
             return 1;
         }
-        char *Filename = Args[2];
-        char Puzzle[PUZZLE_SIZE];
-        char FileContents[PUZZLE_SIZE + PUZZLE_HEIGHT - 1];
+        if (!CheckProfileOutput(ProfileOutput))
+        {
+            return 1;
+        }
+        char FileContents[4*PUZZLE_MAX_CELLS];
         FILE *PuzzleFile = fopen(Filename, "rb");
         if (!PuzzleFile)
         {
             printf("Failed to open file %s\n", Filename);
             return 1;
         }
-        if (sizeof(FileContents) != fread(FileContents, 1, sizeof(FileContents), PuzzleFile))
+        size_t FileSize = fread(FileContents, 1, sizeof(FileContents), PuzzleFile);
+        fclose(PuzzleFile);
+        struct strands_puzzle Puzzle;
+        if (!ParseStrandsPuzzle(FileContents, FileSize, &Puzzle) ||
+            !SetStrandsUnknownCells(&Puzzle, Unknown, MaxWildcards))
         {
-            printf("Expected file to contain eight lines of six characters each.\n");
+            printf("Expected file to contain rows of equal length, at most %d cells.\n", PUZZLE_MAX_CELLS);
             return 1;
         }
 
-        struct trie_builder Builder = BuildTrieFromLexicon(&Arena, ReadLexicon(ExecutablePath));
+        struct dictionary Dictionary = LoadDictionary(&Arena, Assets, DictionaryKind);
 
         struct solution_builder SolutionBuilder = {0};
-        SolutionBuilder.StringArena.Size = 16*1024;
-        SolutionBuilder.StringArena.Memory = ArenaPush(&Arena, SolutionBuilder.StringArena.Size);
-        SolutionBuilder.SolutionArena.Size = 64*1024;
-        SolutionBuilder.SolutionArena.Memory = ArenaPush(&Arena, SolutionBuilder.SolutionArena.Size);
-        SolutionBuilder.CombinationArena.Size = 64*1024*1024;
-        SolutionBuilder.CombinationArena.Memory = ArenaPush(&Arena, SolutionBuilder.CombinationArena.Size);
-
-#if 0
-        printf("Allocated: %zu / %zu (%f)\n", Builder.Arena.Allocated, Builder.Arena.Size, (float)Builder.Arena.Allocated / (float)Builder.Arena.Size);
-        struct trie_node *Node = Builder.Root.FirstChild;
-        while (Node)
-        {
-            printf("%c", Node->Value & 0x7F);
-            Node = Node->FirstChild;
-        }
-        printf("\n");
-#endif
-    
-        char PuzzleWithApron[(PUZZLE_HEIGHT+2)*(PUZZLE_WIDTH+2)] = {0};
-        char Visited[(PUZZLE_HEIGHT+2)*(PUZZLE_WIDTH+2)];
-        char *Source = FileContents;
-        char *Dest = PuzzleWithApron + PUZZLE_WIDTH + 3;
-        for (int RowIndex = 0; RowIndex < PUZZLE_HEIGHT; ++RowIndex)
-        {
-            memcpy(Dest, Source, PUZZLE_WIDTH);
-            Dest += STRIDE;
-            Source += PUZZLE_WIDTH + 1;
-            if (*Source == '\n')
-            {
-                Source++;
-            }
-        }
+        SolutionBuilder.StringArena = ReserveArena(256*1024*1024, "strings");
+        SolutionBuilder.SolutionArena = ReserveArena(256*1024*1024, "solutions");
 
-        int RowOffset = PUZZLE_WIDTH + 3;
-        for (int RowIndex = 0; RowIndex < PUZZLE_HEIGHT; ++RowIndex)
-        {
-            for (int ColIndex = 0; ColIndex < PUZZLE_WIDTH; ++ColIndex)
-            {
-                int PuzzleIndex = RowOffset + ColIndex;
-                char Buffer[256];
-                memset(Visited, 0, sizeof(Visited));
-                Solve(PuzzleWithApron, PuzzleIndex, Visited, Buffer, 0, &Builder.Root, &SolutionBuilder);
-            }
-            RowOffset += STRIDE;
-        }
+        SolveStrands(&Arena, &Dictionary, &Puzzle, &SolutionBuilder, ThreadCount);
 
         struct solution *Solutions = (struct solution *)SolutionBuilder.SolutionArena.Memory;
+        BeginOutput(&Output, stdout, OutputFormat, SummaryOnly, &Puzzle);
 #if 1
-        printf("Solutions: %zu\n", SolutionBuilder.SolutionCount);
+        OutputCount(&Output, "solutions", "Solutions", SolutionBuilder.SolutionCount);
         for (int SolutionIndex = 0; SolutionIndex < SolutionBuilder.SolutionCount; ++SolutionIndex)
         {
-            struct solution Solution = Solutions[SolutionIndex];
-            printf("%.*s (%llu)\n", Solution.Length, Solution.Word, Solution.PuzzleMask);
+            OutputSolution(&Output, &Puzzle, Solutions + SolutionIndex);
         }
 #endif
-#if 1
-        struct combination Combination = {0};
-        Combine(&SolutionBuilder, &Combination, 0, 0);
-        struct combination *Combinations = (struct combination *)SolutionBuilder.CombinationArena.Memory;
-        printf("Combinations: %zu\n", SolutionBuilder.CombinationCount);
-        int Most = 0;
-        int Best = 0;
-        for (int CombinationIndex = 0; CombinationIndex < SolutionBuilder.CombinationCount; ++CombinationIndex)
-        {
-            uint64_t Mask = 0;
-            Combination = Combinations[CombinationIndex];
-            for (int IndexIndex = 0; IndexIndex < Combination.Count; ++IndexIndex)
+        if (ExactCoverOnly)
+        {
+            size_t CoverCount = ExactCover(&Arena, &Puzzle, &SolutionBuilder, RequireSpangram, PrintCombination, 0);
+            OutputCount(&Output, "exact_covers", "Exact covers", CoverCount);
+            FlushOutput(&Output);
+            ReportProfile(ProfileOutput);
+            return 0;
+        }
+        if (BestOnly)
+        {
+            struct combine_summary Summary;
+            uint64_t TilingCount = CombineMemoized(&Arena, &Puzzle, &SolutionBuilder, &Summary);
+            size_t Lookups = SolutionBuilder.CombineMemoLookups;
+            size_t Hits = SolutionBuilder.CombineMemoHits;
+            OutputCount(&Output, "tilings", "Tilings", TilingCount);
+            if (Output.Format == output_format_Text)
             {
-                struct solution Solution = Solutions[Combination.Indices[IndexIndex]];
-                printf("%.*s\n", Solution.Length, Solution.Word);
-                Mask = Mask | Solution.PuzzleMask;
+                OutputText(&Output, "Best coverage: %d / %d\n", Summary.BestCovered, Puzzle.CellCount);
+                OutputWords(&Output, "best", Solutions, Summary.Best.Indices, Summary.Best.Count);
+                OutputText(&Output, "Memo: %zu lookups, %zu hits (%.1f%%), %zu states\n",
+                           Lookups, Hits, Lookups ? 100.0*Hits / Lookups : 0.0, Summary.MemoStates);
             }
-            printf("====\n");
-            int Test = CountSetBits(Mask);
-            if (Most < Test)
+            else
             {
-                Most = Test;
-                Best = CombinationIndex;
+                OutputCount(&Output, "best_covered", 0, Summary.BestCovered);
+                OutputCount(&Output, "cells", 0, Puzzle.CellCount);
+                OutputWords(&Output, "best", Solutions, Summary.Best.Indices, Summary.Best.Count);
+                OutputCount(&Output, "memo_lookups", 0, Lookups);
+                OutputCount(&Output, "memo_hits", 0, Hits);
+                OutputCount(&Output, "memo_states", 0, Summary.MemoStates);
             }
+            FlushOutput(&Output);
+            ReportProfile(ProfileOutput);
+            return 0;
         }
-        Combination = Combinations[Best];
-        for (int IndexIndex = 0; IndexIndex < Combination.Count; ++IndexIndex)
-        {
-            struct solution Solution = Solutions[Combination.Indices[IndexIndex]];
-            printf("%.*s\n", Solution.Length, Solution.Word);
-        }
+#if 1
+        struct best_combination Best = {0};
+        size_t CombinationCount = Combine(&Puzzle, &SolutionBuilder, CombineMode, PrintCombination, &Best);
+        OutputCount(&Output, "combinations", "Combinations", CombinationCount);
+        OutputWords(&Output, "best", Solutions, Best.Combination.Indices, Best.Combination.Count);
 #endif
+        FlushOutput(&Output);
 #if 1
-        PrintArenaStats(Builder.Arena);
-        PrintArenaStats(SolutionBuilder.SolutionArena);
-        PrintArenaStats(SolutionBuilder.StringArena);
-        PrintArenaStats(SolutionBuilder.CombinationArena);
+        if (OutputFormat == output_format_Text)
+        {
+            PrintArenaStats(&Arena);
+            PrintArenaStats(&SolutionBuilder.SolutionArena);
+            PrintArenaStats(&SolutionBuilder.StringArena);
+        }
 #endif
+        ReportProfile(ProfileOutput);
     }
     else if (0 == strcmp(GameName, "bee"))
     {
         int ArgIndex = 2;
         char ShowPangrams = 0;
         char *LetterBank = 0;
+        char UseIndex = 1;
+        enum dictionary_kind DictionaryKind = dictionary_kind_Dawg;
+        enum profile_output ProfileOutput = profile_output_None;
+        char *TablePath = 0;
+        char *WriteTablePath = 0;
         for (int ArgIndex = 2; ArgIndex < ArgCount; ++ArgIndex)
         {
             char *Arg = Args[ArgIndex];
@@ -182,9 +667,32 @@ int main(int ArgCount, char *Args[])
                 {
                     ShowPangrams = 1;
                 }
+                else if (0 == strcmp("-d", Arg) || 0 == strcmp("--dictionary", Arg))
+                {
+                    if (!ParseBeeDictionaryKind(++ArgIndex < ArgCount ? Args[ArgIndex] : 0, &DictionaryKind, &UseIndex))
+                    {
+                        return 1;
+                    }
+                }
+                else if (0 == strcmp("-t", Arg) || 0 == strcmp("--table", Arg))
+                {
+                    TablePath = ++ArgIndex < ArgCount ? Args[ArgIndex] : 0;
+                }
+                else if (0 == strcmp("--write-table", Arg))
+                {
+                    WriteTablePath = ++ArgIndex < ArgCount ? Args[ArgIndex] : 0;
+                }
+                else if (0 == strcmp("--profile", Arg))
+                {
+                    ProfileOutput = profile_output_Table;
+                }
+                else if (0 == strcmp("--profile-json", Arg))
+                {
+                    ProfileOutput = profile_output_Json;
+                }
                 else
                 {
-                    printf("Unrecognized option %s\nValid options are: -p", Arg);
+                    printf("Unrecognized option %s\nValid options are: -p, -d, -t, --write-table, --profile, --profile-json", Arg);
                     return 1;
                 }
             }
@@ -193,9 +701,20 @@ int main(int ArgCount, char *Args[])
                 LetterBank = Arg;
             }
         }
+        if (!CheckProfileOutput(ProfileOutput))
+        {
+            return 1;
+        }
+        if (WriteTablePath)
+        {
+            int Written = WriteBeePuzzleTable(&Arena, Assets, WriteTablePath);
+            ReportProfile(ProfileOutput);
+            return !Written;
+        }
         if (!LetterBank)
         {
-            printf("usage: %s %s [-p] ABCDEFG\n", ExecutableName, GameName);
+            printf("usage: %s %s [-p] [-d index|trie|dawg] [-t table] [--profile|--profile-json] ABCDEFG\n"
+                   "       %s %s --write-table table\n", ExecutableName, GameName, ExecutableName, GameName);
             return 1;
         }
         char SortedLetterBank[SPELLING_BEE_LETTER_BANK_SIZE + 1];
@@ -293,11 +812,34 @@ int main(int ArgCount, char *Args[])
             }
         }
         *Dest = 0;
-        char *Lexicon = ReadLexicon(ExecutablePath);
-        struct memory_arena SolveArena = {0};
-        SolveArena.Size = Arena.Size - Arena.Allocated;
-        SolveArena.Memory = ArenaPush(&Arena, SolveArena.Size);
-        struct spelling_bee_solution_builder *SolutionBuilder = SolveSpellingBee(SolveArena.Memory, SolveArena.Size, Lexicon, SortedLetterBank, CoreMask);
+        if (TablePath)
+        {
+            struct bee_puzzle_table Table = MapBeePuzzleTable(TablePath);
+            uint32_t LetterMask = 0;
+            for (char *Letter = SortedLetterBank; *Letter; ++Letter)
+            {
+                LetterMask |= 1u << (*Letter - 'A');
+            }
+            struct bee_puzzle_stats Stats;
+            if (!QueryBeePuzzle(&Table, LetterMask, CoreChar - 'A', &Stats))
+            {
+                return 1;
+            }
+            printf("Words: %u\nPangrams: %u\nPoints: %u\n", Stats.WordCount, Stats.PangramCount, Stats.Points);
+            ReportProfile(ProfileOutput);
+            return 0;
+        }
+        struct spelling_bee_solution_builder *SolutionBuilder;
+        if (UseIndex)
+        {
+            struct bee_index Index = LoadBeeIndex(&Arena, Assets);
+            SolutionBuilder = SolveSpellingBeeWithIndex(&Arena, &Index, SortedLetterBank, CoreMask);
+        }
+        else
+        {
+            struct dictionary Dictionary = LoadDictionary(&Arena, Assets, DictionaryKind);
+            SolutionBuilder = SolveSpellingBeeWithDictionary(&Arena, &Dictionary, SortedLetterBank, CoreMask);
+        }
         struct spelling_bee_solution *Solution = (struct spelling_bee_solution *)SolutionBuilder->SolutionArena.Memory;
         if (ShowPangrams)
         {
@@ -318,10 +860,11 @@ int main(int ArgCount, char *Args[])
                 Solution++;
             }
         }
+        ReportProfile(ProfileOutput);
     }
     else
     {
-        printf("usage: %s strands|bee <param>\n", ExecutableName);
+        printf("usage: %s strands|bee|batch|serve <param>\n", ExecutableName);
         return 1;
     }
 
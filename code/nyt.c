@@ -4,84 +4,289 @@
 #define PUZZLE_HEIGHT 8
 #define PUZZLE_WIDTH 6
 #define PUZZLE_SIZE (PUZZLE_HEIGHT * PUZZLE_WIDTH)
-#define STRIDE (PUZZLE_WIDTH + 2)
+#define PUZZLE_MAX_CELLS 512
+#define CELL_MASK_WORDS (PUZZLE_MAX_CELLS / 64)
 #define MIN_LENGTH 4
-#define MAX_WORDS ((PUZZLE_HEIGHT * PUZZLE_WIDTH) / MIN_LENGTH)
+#define MAX_WORDS (PUZZLE_MAX_CELLS / MIN_LENGTH)
+#define FULL_PUZZLE_MASK ((((uint64_t)1) << PUZZLE_SIZE) - 1)
 #define SPELLING_BEE_LETTER_BANK_SIZE 7
+#define UNKNOWN_CELL '0'
+#define DEFAULT_MAX_WILDCARDS 2
+
+#include "nyt_profile.c"
 
 #define PushType(Arena, Type) ((Type *)ArenaPush(Arena, sizeof(Type)))
 #define PushStruct(Arena, Type) ((struct Type *)ArenaPush(Arena, sizeof(struct Type)))
+#define PushArray(Arena, Count, Type) ((Type *)ArenaPush(Arena, (Count)*sizeof(Type)))
+
+#define ARENA_COMMIT_GRANULARITY (64*1024)
+
+enum strands_board
+{
+    strands_board_Fixed,
+    strands_board_Narrow,
+    strands_board_Wide,
+};
+
+enum unknown_cells
+{
+    unknown_cells_Literal,
+    unknown_cells_Blocked,
+    unknown_cells_Wildcard,
+};
+
+enum board_edge
+{
+    board_edge_Top,
+    board_edge_Bottom,
+    board_edge_Left,
+    board_edge_Right,
+};
+
+struct cell_mask
+{
+    uint64_t Words[CELL_MASK_WORDS];
+};
+
+struct narrow_geometry
+{
+    uint64_t FullMask;
+    uint64_t EdgeMasks[4];
+    uint64_t NeighborMasks[64];
+    uint64_t LetterMasks[26];
+    uint64_t UnknownMask;
+};
+
+struct wide_geometry
+{
+    struct cell_mask FullMask;
+    struct cell_mask EdgeMasks[4];
+    struct cell_mask NeighborMasks[PUZZLE_MAX_CELLS];
+    struct cell_mask LetterMasks[26];
+    struct cell_mask UnknownMask;
+};
 
-char Offsets[] = {
-    -STRIDE - 1,
-    -STRIDE,
-    -STRIDE + 1,
-    -1,
-    +1,
-    STRIDE - 1,
-    STRIDE,
-    STRIDE + 1,
+struct strands_puzzle
+{
+    enum strands_board Board;
+    int Width;
+    int Height;
+    int CellCount;
+    enum unknown_cells Unknown;
+    int MaxWildcards;
+    char Letters[PUZZLE_MAX_CELLS];
+    uint8_t KnownDistances[PUZZLE_MAX_CELLS];
+    struct narrow_geometry Narrow;
+    struct wide_geometry Wide;
+};
+
+enum arena_flag
+{
+    arena_flag_FailHard = 0x1,
 };
 
+struct memory_arena;
+typedef int arena_commit(void *Memory, size_t Size);
+typedef void arena_overflow(struct memory_arena *Arena, size_t Requested);
+
 struct memory_arena
 {
     size_t Size;
     size_t Allocated;
     char *Memory;
+    size_t Reserved;
+    size_t HighWater;
+    size_t PushCount;
+    uint32_t Flags;
+    char *Name;
+    arena_commit *Commit;
+    arena_overflow *Overflow;
+};
+
+struct temporary_memory
+{
+    struct memory_arena *Arena;
+    size_t Allocated;
 };
 
 struct solution
 {
     char Length;
     char *Word;
-    uint64_t PuzzleMask;
+    union
+    {
+        uint64_t PuzzleMask;
+        struct cell_mask *Cells;
+    };
 };
 
 struct combination
 {
-    char Count;
+    int Count;
     int Indices[MAX_WORDS];
 };
 
 struct combine_memo
 {
-    int StartIndex;
-    uint64_t PuzzleMask;
-    
+    union
+    {
+        uint64_t PuzzleMask;
+        struct cell_mask *Cells;
+    };
+    int Covered;
+    uint64_t TilingCount;
+};
+
+struct combine_summary
+{
+    int BestCovered;
+    uint64_t TilingCount;
+    size_t MemoStates;
+    struct combination Best;
 };
 
 struct solution_builder
 {
     size_t SolutionCount;
-    size_t CombinationCount;
     struct memory_arena StringArena;
     struct memory_arena SolutionArena;
-    struct memory_arena CombinationArena;
+    size_t NodesVisited;
+    size_t NodesPruned;
+    size_t CombineNodesVisited;
+    size_t CombineMemoLookups;
+    size_t CombineMemoHits;
 };
 
+static int ArenaGrow(struct memory_arena *Arena, size_t NewAllocated)
+{
+    int Result = 0;
+    if (Arena->Commit && NewAllocated <= Arena->Reserved)
+    {
+        size_t NewSize = Arena->Size ? Arena->Size : ARENA_COMMIT_GRANULARITY;
+        while (NewSize < NewAllocated)
+        {
+            NewSize *= 2;
+        }
+        if (Arena->Reserved < NewSize)
+        {
+            NewSize = Arena->Reserved;
+        }
+        if (Arena->Commit(Arena->Memory + Arena->Size, NewSize - Arena->Size))
+        {
+            Arena->Size = NewSize;
+            Result = 1;
+        }
+    }
+    return Result;
+}
+
 void *ArenaPush(struct memory_arena *Arena, size_t Size)
 {
     void *Result = 0;
     size_t NewAllocated = Arena->Allocated + Size;
-    if (NewAllocated <= Arena->Size)
+    if (NewAllocated <= Arena->Size || ArenaGrow(Arena, NewAllocated))
     {
         Result = Arena->Memory + Arena->Allocated;
         Arena->Allocated = NewAllocated;
+        Arena->PushCount++;
+        PROFILE_COUNT(ArenaPushes, 1);
+        PROFILE_COUNT(ArenaBytes, Size);
+        if (Arena->HighWater < NewAllocated)
+        {
+            Arena->HighWater = NewAllocated;
+        }
     }
-#if 0
     else
     {
-        printf("Pushed too much on arena! (%zu / %zu)\n", NewAllocated, Arena->Size);
+        if (Arena->Overflow)
+        {
+            Arena->Overflow(Arena, Size);
+        }
+        if (Arena->Flags & arena_flag_FailHard)
+        {
+            __builtin_trap();
+        }
     }
-#endif
     return Result;
 }
 
+static inline void *ArenaPushAligned(struct memory_arena *Arena, size_t Size, size_t Alignment)
+{
+    ArenaPush(Arena, (0 - (uintptr_t)(Arena->Memory + Arena->Allocated)) & (Alignment - 1));
+    return ArenaPush(Arena, Size);
+}
+
+struct memory_arena SubArena(struct memory_arena *Parent, size_t Size, char *Name)
+{
+    struct memory_arena Result = {0};
+    Result.Memory = (char *)ArenaPush(Parent, Size);
+    Result.Size = Result.Memory ? Size : 0;
+    Result.Flags = Parent->Flags;
+    Result.Name = Name;
+    Result.Overflow = Parent->Overflow;
+    return Result;
+}
+
+static inline void ResetArena(struct memory_arena *Arena)
+{
+    Arena->Allocated = 0;
+}
+
+static inline struct temporary_memory BeginTemporaryMemory(struct memory_arena *Arena)
+{
+    struct temporary_memory Result;
+    Result.Arena = Arena;
+    Result.Allocated = Arena->Allocated;
+    return Result;
+}
+
+static inline void EndTemporaryMemory(struct temporary_memory Temporary)
+{
+    Temporary.Arena->Allocated = Temporary.Allocated;
+}
+
 struct trie_node
 {
     char Value;
-    struct trie_node *FirstChild;
-    struct trie_node *Sibling;
+    int32_t FirstChild;
+    int32_t Sibling;
+};
+
+#define TRIE_IMAGE_MAGIC ('N' | ('Y' << 8) | ('T' << 16) | ('T' << 24))
+#define TRIE_IMAGE_VERSION 3
+#define TRIE_BUILDER_ARENA_SIZE (32*1024*1024)
+
+struct trie_image_header
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t WordCount;
+    uint32_t NodeCount;
+};
+
+#define PACKED_ASSETS_MAGIC ('N' | ('Y' << 8) | ('T' << 16) | ('A' << 24))
+#define PACKED_ASSETS_VERSION 5
+
+enum packed_asset_type
+{
+    packed_asset_Lexicon,
+    packed_asset_DawgImage,
+    packed_asset_BeeIndexImage,
+
+    packed_asset_Count,
+};
+
+struct packed_asset
+{
+    uint64_t Offset;
+    uint64_t Size;
+};
+
+struct packed_assets_header
+{
+    uint32_t Magic;
+    uint32_t Version;
+    struct packed_asset Assets[packed_asset_Count];
 };
 
 static inline char TrieMatch(struct trie_node *Node, char Char)
@@ -94,13 +299,15 @@ static inline char TrieTerminal(struct trie_node *Node)
     return Node->Value & 0x80;
 }
 
-struct trie_builder
+static inline struct trie_node *TrieFirstChild(struct trie_node *Node)
 {
-    size_t WordCount;
-    char *Stream;
-    struct trie_node Root;
-    struct memory_arena Arena;
-};
+    return Node->FirstChild ? Node + Node->FirstChild : 0;
+}
+
+static inline struct trie_node *TrieSibling(struct trie_node *Node)
+{
+    return Node->Sibling ? Node + Node->Sibling : 0;
+}
 
 #pragma pack(push, 1)
 struct spelling_bee_solution_builder
@@ -108,6 +315,7 @@ struct spelling_bee_solution_builder
     size_t SolutionCount;
     struct memory_arena StringArena;
     struct memory_arena SolutionArena;
+    size_t NodesVisited;
 };
 
 struct spelling_bee_solution
@@ -120,14 +328,40 @@ struct spelling_bee_solution
 
 struct trie_node *TrieFindChild(struct trie_node *Node, char Char)
 {
-    struct trie_node *Child = Node->FirstChild;
+    struct trie_node *Child = TrieFirstChild(Node);
+    PROFILE_COUNT(TrieFindChildCalls, 1);
+    PROFILE_COUNT(TrieNodesTouched, Child != 0);
     while (Child && !TrieMatch(Child, Char))
     {
-        Child = Child->Sibling;
+        Child = TrieSibling(Child);
+        PROFILE_COUNT(TrieNodesTouched, Child != 0);
+        PROFILE_COUNT(TrieSiblingSteps, 1);
     }
     return Child;
 }
 
+#define NODE_SUMMARY_LETTER_BITS 0x03FFFFFFu
+#define NODE_SUMMARY_LENGTH_SHIFT 26
+#define NODE_SUMMARY_MAX_LENGTH 63u
+#define NODE_SUMMARY_EMPTY (NODE_SUMMARY_LETTER_BITS | (NODE_SUMMARY_MAX_LENGTH << NODE_SUMMARY_LENGTH_SHIFT))
+
+static inline uint32_t NodeSummaryLength(uint32_t Summary)
+{
+    return Summary >> NODE_SUMMARY_LENGTH_SHIFT;
+}
+
+static inline uint32_t MergeNodeSummary(uint32_t Summary, char Char, uint32_t ChildSummary)
+{
+    uint32_t Letter = (uint32_t)(Char - 'A');
+    uint32_t Letters = Summary & (ChildSummary | (Letter < 26 ? 1u << Letter : 0)) & NODE_SUMMARY_LETTER_BITS;
+    uint32_t Length = NodeSummaryLength(ChildSummary) + 1;
+    if (NodeSummaryLength(Summary) < Length)
+    {
+        Length = NodeSummaryLength(Summary);
+    }
+    return Letters | (Length << NODE_SUMMARY_LENGTH_SHIFT);
+}
+
 int Copy(void *Destination, void *Source, size_t Length)
 {
     size_t Result = Length;
@@ -140,175 +374,1397 @@ int Copy(void *Destination, void *Source, size_t Length)
     return Result;
 }
 
-void Solve(char *PuzzleWithApron, int PuzzleIndex, char *Visited, char *Buffer, int Length, struct trie_node *Node, struct solution_builder *Builder)
+#include "nyt_simd.c"
+
+#define LEXICON_IMAGE_MAGIC ('N' | ('Y' << 8) | ('T' << 16) | ('L' << 24))
+#define LEXICON_IMAGE_VERSION 1
+#define LEXICON_MAX_WORD 255
+#define LEXICON_LAST_CHAR 0x80
+
+struct lexicon_image_header
 {
-    char Char = PuzzleWithApron[PuzzleIndex];
-    if (!Visited[PuzzleIndex])
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t WordCount;
+    uint32_t TextSize;
+};
+
+static size_t EncodeLexicon(char *Lexicon, size_t Size, struct lexicon_image_header *Header, char *Dest)
+{
+    size_t Result = sizeof(*Header);
+    char *Previous = 0;
+    size_t PreviousLength = 0;
+    Header->WordCount = 0;
+    Header->TextSize = 0;
+    char *End = Lexicon + Size;
+    for (char *LineStart = Lexicon; LineStart < End;)
     {
-        Visited[PuzzleIndex] = 1;
-        struct trie_node *Child = TrieFindChild(Node, Char);
-        if (Child)
+        char *LineEnd = LineStart;
+        char IsAscii = 1;
+        while (LineEnd < End && *LineEnd != '\n')
+        {
+            IsAscii &= 0 < (uint8_t)*LineEnd && (uint8_t)*LineEnd < LEXICON_LAST_CHAR;
+            LineEnd++;
+        }
+        size_t Length = LineEnd - LineStart;
+        while (Length && LineStart[Length - 1] == '\r')
+        {
+            Length--;
+        }
+        if (Length && Length <= LEXICON_MAX_WORD && IsAscii)
         {
-            Buffer[Length++] = Char;
-            if (Length >= MIN_LENGTH && TrieTerminal(Child))
+            size_t Shared = 0;
+            while (Shared < PreviousLength && Shared < Length && Shared < LEXICON_MAX_WORD && Previous[Shared] == LineStart[Shared])
             {
-                struct solution *Solution = PushStruct(&Builder->SolutionArena, solution);
-                Solution->PuzzleMask = 0;
-                int MaskIndex = 0;
-                char *Row = Visited + PUZZLE_WIDTH + 3;
-                for (int RowIndex = 0; RowIndex < PUZZLE_HEIGHT; ++RowIndex)
-                {
-                    char *At = Row;
-                    for (int ColIndex = 0; ColIndex < PUZZLE_WIDTH; ++ColIndex)
-                    {
-                        Solution->PuzzleMask = Solution->PuzzleMask | (*At++ << MaskIndex++);
-                    }
-                    Row += STRIDE;
-                }
-                Solution->Length = Length;
-                Solution->Word = ArenaPush(&Builder->StringArena, Length);
-                Copy(Solution->Word, Buffer, Length);
-                Builder->SolutionCount++;
+                Shared++;
             }
-            for (int OffsetIndex = 0; OffsetIndex < sizeof(Offsets); ++OffsetIndex)
+            if (Shared == Length)
             {
-                Solve(PuzzleWithApron, PuzzleIndex + Offsets[OffsetIndex], Visited, Buffer, Length, Child, Builder);
+                Shared--;
             }
+            if (Dest)
+            {
+                Dest[Result] = (char)Shared;
+                Copy(Dest + Result + 1, LineStart + Shared, Length - Shared);
+                Dest[Result + Length - Shared] |= LEXICON_LAST_CHAR;
+            }
+            Result += 1 + Length - Shared;
+            Header->WordCount++;
+            Header->TextSize += (uint32_t)(Length + 1);
+            Previous = LineStart;
+            PreviousLength = Length;
         }
-        Visited[PuzzleIndex] = 0;
+        LineStart = LineEnd + 1;
     }
+    return Result;
 }
 
-void BuildTrie(struct trie_builder *Builder)
+size_t LexiconImageSize(char *Lexicon, size_t Size)
+{
+    struct lexicon_image_header Header;
+    return EncodeLexicon(Lexicon, Size, &Header, 0);
+}
+
+void WriteLexiconImage(char *Lexicon, size_t Size, void *Destination)
+{
+    struct lexicon_image_header *Header = (struct lexicon_image_header *)Destination;
+    EncodeLexicon(Lexicon, Size, Header, (char *)Destination);
+    Header->Magic = LEXICON_IMAGE_MAGIC;
+    Header->Version = LEXICON_IMAGE_VERSION;
+}
+
+struct lexicon_reader
+{
+    char *At;
+    char *End;
+    uint32_t WordsLeft;
+    char IsImage;
+    int Length;
+    int Shared;
+    char *Word;
+    char Buffer[LEXICON_MAX_WORD];
+};
+
+static struct lexicon_reader BeginLexicon(char *Lexicon, size_t Size)
+{
+    struct lexicon_reader Reader = {0};
+    struct lexicon_image_header *Header = (struct lexicon_image_header *)Lexicon;
+    Reader.At = Lexicon;
+    Reader.End = Lexicon + Size;
+    if (sizeof(*Header) <= Size &&
+        Header->Magic == LEXICON_IMAGE_MAGIC &&
+        Header->Version == LEXICON_IMAGE_VERSION)
+    {
+        Reader.IsImage = 1;
+        Reader.WordsLeft = Header->WordCount;
+        Reader.At += sizeof(*Header);
+    }
+    return Reader;
+}
+
+static int NextLexiconWord(struct lexicon_reader *Reader)
 {
-    char Char = *Builder->Stream++;
-    struct trie_node *Node = &Builder->Root;
-    char OrMask = 0x80;
-    while (Char)
+    char *At = Reader->At;
+    char *End = Reader->End;
+    if (Reader->IsImage)
     {
-        if ('\n' == Char)
+        if (!Reader->WordsLeft || End <= At || Reader->Length < (uint8_t)*At)
         {
-            Node->Value = OrMask | Node->Value;
-            Node = &Builder->Root;
-            OrMask = 0x80;
-            Builder->WordCount++;
+            return 0;
         }
-        else
+        int Length = (uint8_t)*At++;
+        Reader->Shared = Length;
+        char Char = 0;
+        while (At < End && Length < LEXICON_MAX_WORD && !(Char & LEXICON_LAST_CHAR))
         {
-            if ('a' <= Char && Char <= 'z')
+            Char = *At++;
+            Reader->Buffer[Length++] = Char & ~LEXICON_LAST_CHAR;
+        }
+        if (!(Char & LEXICON_LAST_CHAR))
+        {
+            return 0;
+        }
+        Reader->WordsLeft--;
+        Reader->At = At;
+        Reader->Word = Reader->Buffer;
+        Reader->Length = Length;
+        return 1;
+    }
+
+    while (At < End && *At)
+    {
+        char *Start = At;
+        At = FindLineEnd(At, End);
+        char *WordEnd = At;
+        while (Start < WordEnd && WordEnd[-1] == '\r')
+        {
+            WordEnd--;
+        }
+        if (At < End && *At == '\n')
+        {
+            At++;
+        }
+        if (Start < WordEnd)
+        {
+            int Length = (int)(WordEnd - Start);
+            int Shared = 0;
+            while (Shared < Length && Shared < Reader->Length && Reader->Word[Shared] == Start[Shared])
             {
-                Char = 'A' + (Char - 'a');
+                Shared++;
+            }
+            Reader->Shared = Shared;
+            Reader->At = At;
+            Reader->Word = Start;
+            Reader->Length = Length;
+            return 1;
+        }
+    }
+    Reader->At = At;
+    return 0;
+}
+
+struct trie_builder
+{
+    size_t WordCount;
+    size_t NodeCount;
+    struct lexicon_reader Reader;
+    struct trie_node *Root;
+    struct memory_arena Arena;
+    char Sorted;
+    int PathLength;
+    struct trie_node *Path[LEXICON_MAX_WORD + 1];
+};
+
+static struct trie_node *PushTrieNode(struct trie_builder *Builder, char Value)
+{
+    struct trie_node *Node = PushStruct(&Builder->Arena, trie_node);
+    Node->Value = Value;
+    Node->FirstChild = 0;
+    Node->Sibling = 0;
+    Builder->NodeCount++;
+    return Node;
+}
+
+static inline char UpperCase(char Char)
+{
+    return ('a' <= Char && Char <= 'z') ? 'A' + (Char - 'a') : Char;
+}
+
+static inline char IsLetter(char Char)
+{
+    Char = UpperCase(Char);
+    return 'A' <= Char && Char <= 'Z';
+}
+
+static void AppendTrieChild(struct trie_node *Node, struct trie_node *Child)
+{
+    if (Node->FirstChild)
+    {
+        Child->Sibling = (int32_t)(TrieFirstChild(Node) - Child);
+    }
+    Node->FirstChild = (int32_t)(Child - Node);
+}
+
+void BuildTrie(struct trie_builder *Builder)
+{
+    PROFILE_BLOCK_BEGIN(BuildTrie);
+    struct lexicon_reader *Reader = &Builder->Reader;
+    char Upper[LEXICON_MAX_WORD];
+    if (!Builder->Root)
+    {
+        Builder->Root = PushTrieNode(Builder, 0);
+        Builder->Path[0] = Builder->Root;
+        Builder->PathLength = 1;
+        Builder->Sorted = 1;
+    }
+    while (NextLexiconWord(Reader))
+    {
+        int Length = Reader->Length;
+        int Shared = Reader->Shared;
+        char IsWord = Length <= LEXICON_MAX_WORD && UpperCaseWord(Upper, Reader->Word, Length);
+        Builder->Sorted &= (IsWord && Shared < Length && Shared < Builder->PathLength &&
+                            (Shared + 1 == Builder->PathLength ||
+                             (Builder->Path[Shared + 1]->Value & 0x7F) < Upper[Shared]));
+
+        struct trie_node *Node;
+        if (Builder->Sorted)
+        {
+            Node = Builder->Path[Shared];
+            for (int CharIndex = Shared; CharIndex < Length; ++CharIndex)
+            {
+                struct trie_node *Child = PushTrieNode(Builder, Upper[CharIndex]);
+                AppendTrieChild(Node, Child);
+                Builder->Path[CharIndex + 1] = Node = Child;
             }
-            if ('A' <= Char && Char <= 'Z')
+            Builder->PathLength = Length + 1;
+        }
+        else
+        {
+            Node = Builder->Root;
+            IsWord = 1;
+            for (int CharIndex = 0; CharIndex < Length; ++CharIndex)
             {
-                struct trie_node *Child = TrieFindChild(Node, Char);
-                if (!Child)
+                char Char = UpperCase(Reader->Word[CharIndex]);
+                if ('A' <= Char && Char <= 'Z')
                 {
-                    Child = PushStruct(&Builder->Arena, trie_node);
-                    Child->Value = Char;
-                    Child->FirstChild = 0;
-                    Child->Sibling = Node->FirstChild;
-                    Node->FirstChild = Child;
+                    struct trie_node *Child = TrieFindChild(Node, Char);
+                    if (!Child)
+                    {
+                        Child = PushTrieNode(Builder, Char);
+                        AppendTrieChild(Node, Child);
+                    }
+                    Node = Child;
+                }
+                else
+                {
+                    IsWord = 0;
                 }
-                Node = Child;
-            }
-            else
-            {
-                OrMask = 0;
             }
         }
-        Char = *Builder->Stream++;
+        if (IsWord)
+        {
+            Node->Value |= 0x80;
+        }
+        Builder->WordCount++;
     }
+    PROFILE_BLOCK_END(BuildTrie);
 }
 
-int CountSetBits(uint64_t Integer)
+int SplitLexicon(char *Lexicon, size_t Size, struct lexicon_reader *Shards, int MaxShardCount)
 {
-    unsigned int Result = 0;
-    while (Integer > 0)
+    char *GroupStarts[27];
+    uint32_t GroupWords[26] = {0};
+    char GroupLetters[26];
+    char Seen[26] = {0};
+    int GroupCount = 0;
+    uint32_t WordCount = 0;
+
+    struct lexicon_reader Reader = BeginLexicon(Lexicon, Size);
+    char *WordStart = Reader.At;
+    while (NextLexiconWord(&Reader))
     {
-        Integer &= (Integer - 1);
-        Result++;
+        char First = UpperCase(Reader.Word[0]);
+        if (!IsLetter(First) || (Seen[First - 'A'] && First != GroupLetters[GroupCount - 1]))
+        {
+            GroupCount = 0;
+            break;
+        }
+        if (!Seen[First - 'A'])
+        {
+            Seen[First - 'A'] = 1;
+            GroupLetters[GroupCount] = First;
+            GroupStarts[GroupCount++] = WordStart;
+        }
+        GroupWords[GroupCount - 1]++;
+        WordCount++;
+        WordStart = Reader.At;
     }
-    return Result;
+    GroupStarts[GroupCount] = WordStart;
+
+    struct lexicon_reader Whole = BeginLexicon(Lexicon, Size);
+    if (GroupCount < 2 || MaxShardCount < 2)
+    {
+        Shards[0] = Whole;
+        return 1;
+    }
+
+    int ShardCount = 0;
+    int FirstGroup = 0;
+    uint32_t WordsBefore = 0;
+    uint32_t ShardWords = 0;
+    for (int GroupIndex = 0; GroupIndex < GroupCount; ++GroupIndex)
+    {
+        WordsBefore += GroupWords[GroupIndex];
+        ShardWords += GroupWords[GroupIndex];
+        if (GroupIndex + 1 == GroupCount || (uint64_t)WordCount*(ShardCount + 1) <= (uint64_t)WordsBefore*MaxShardCount)
+        {
+            struct lexicon_reader *Shard = Shards + ShardCount++;
+            *Shard = Whole;
+            Shard->At = GroupStarts[FirstGroup];
+            Shard->End = GroupStarts[GroupIndex + 1];
+            Shard->WordsLeft = ShardWords;
+            FirstGroup = GroupIndex + 1;
+            ShardWords = 0;
+        }
+    }
+    return ShardCount;
 }
 
-void Combine(struct solution_builder *Builder, struct combination *Combination, int StartIndex, uint64_t Mask)
+struct trie_builder StitchTrieShards(struct memory_arena *Arena, struct trie_builder *Shards, int ShardCount)
 {
-    struct solution *Solutions = (struct solution *)Builder->SolutionArena.Memory;
-    for (int NextIndex = StartIndex; NextIndex < Builder->SolutionCount; ++NextIndex)
+    struct trie_builder Result = {0};
+    size_t NodeCount = 1;
+    for (int ShardIndex = 0; ShardIndex < ShardCount; ++ShardIndex)
+    {
+        NodeCount += Shards[ShardIndex].NodeCount - 1;
+    }
+    Result.Arena = SubArena(Arena, NodeCount*sizeof(struct trie_node), "trie");
+    Result.Root = PushTrieNode(&Result, 0);
+    for (int ShardIndex = 0; ShardIndex < ShardCount; ++ShardIndex)
     {
-        struct solution Solution = Solutions[NextIndex];
-        if (!(Mask & Solution.PuzzleMask))
+        struct trie_builder *Shard = Shards + ShardIndex;
+        struct trie_node *Nodes = PushArray(&Result.Arena, Shard->NodeCount - 1, struct trie_node);
+        Copy(Nodes, Shard->Root + 1, (Shard->NodeCount - 1)*sizeof(struct trie_node));
+        Result.NodeCount += Shard->NodeCount - 1;
+        Result.WordCount += Shard->WordCount;
+        Result.Root->Value |= Shard->Root->Value;
+        if (Shard->Root->FirstChild)
         {
-            Combination->Indices[Combination->Count++] = NextIndex;
-            Combine(Builder, Combination, NextIndex + 1, Mask | Solution.PuzzleMask);
-            --Combination->Count;
+            struct trie_node *First = Nodes + (Shard->Root->FirstChild - 1);
+            struct trie_node *Last = First;
+            while (Last->Sibling)
+            {
+                Last = TrieSibling(Last);
+            }
+            if (Result.Root->FirstChild)
+            {
+                Last->Sibling = (int32_t)(TrieFirstChild(Result.Root) - Last);
+            }
+            Result.Root->FirstChild = (int32_t)(First - Result.Root);
         }
     }
-    struct combination *Output = PushStruct(&Builder->CombinationArena, combination);
-    *Output = *Combination;
-    Builder->CombinationCount++;
+    return Result;
 }
 
-enum nyt_game
+size_t TrieImageSize(struct trie_builder *Builder)
 {
-    nyt_game_Strands,
-    nyt_game_SpellingBee,
-};
-
-#define PANGRAM_BITS 0x7F
+    return sizeof(struct trie_image_header) + Builder->NodeCount*(sizeof(struct trie_node) + sizeof(uint32_t) + 1) + SIMD_LABEL_PADDING;
+}
 
-void SolveSpellingBee_(struct spelling_bee_solution_builder *SolutionBuilder, char *LetterBank, struct trie_node *TrieNode, char Mask, char *Buffer, int Length, int CoreMask)
+void WriteTrieImage(struct trie_builder *Builder, void *Destination)
 {
-    char *At = LetterBank;
-    if (TrieTerminal(TrieNode) && (Mask & CoreMask) == CoreMask && 4 <= Length)
+    struct trie_image_header *Header = (struct trie_image_header *)Destination;
+    Header->Magic = TRIE_IMAGE_MAGIC;
+    Header->Version = TRIE_IMAGE_VERSION;
+    Header->WordCount = (uint32_t)Builder->WordCount;
+    Header->NodeCount = (uint32_t)Builder->NodeCount;
+
+    struct trie_node *Nodes = (struct trie_node *)(Header + 1);
+    uint32_t *Summaries = (uint32_t *)(Nodes + Builder->NodeCount);
+    uint8_t *Labels = (uint8_t *)(Summaries + Builder->NodeCount);
+    Nodes[0] = *Builder->Root;
+    Nodes[0].FirstChild = 0;
+    Labels[0] = 0;
+    uint32_t NodeCount = 1;
+    for (uint32_t NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
     {
-        struct spelling_bee_solution *Solution = PushStruct(&SolutionBuilder->SolutionArena, spelling_bee_solution);
-        Solution->Mask = Mask;
-        Solution->Length = Length;
-        Solution->Word = ArenaPush(&SolutionBuilder->StringArena, Length);
-        Copy(Solution->Word, Buffer, Length);
-        SolutionBuilder->SolutionCount++;
+        struct trie_node *Old = Builder->Root + Nodes[NodeIndex].FirstChild;
+        struct trie_node *Children[26];
+        int ChildCount = 0;
+        for (struct trie_node *Child = TrieFirstChild(Old); Child; Child = TrieSibling(Child))
+        {
+            int Insert = ChildCount++;
+            while (Insert && (Children[Insert - 1]->Value & 0x7F) > (Child->Value & 0x7F))
+            {
+                Children[Insert] = Children[Insert - 1];
+                Insert--;
+            }
+            Children[Insert] = Child;
+        }
+
+        Nodes[NodeIndex].FirstChild = ChildCount ? (int32_t)(NodeCount - NodeIndex) : 0;
+        for (int ChildIndex = 0; ChildIndex < ChildCount; ++ChildIndex)
+        {
+            char Last = ChildIndex + 1 == ChildCount;
+            struct trie_node *New = Nodes + NodeCount;
+            New->Value = Children[ChildIndex]->Value;
+            New->FirstChild = (int32_t)(Children[ChildIndex] - Builder->Root);
+            New->Sibling = !Last;
+            Labels[NodeCount++] = (Children[ChildIndex]->Value & 0x7F) | (Last ? SIMD_LAST_LABEL : 0);
+        }
     }
-    char Char;
-    int Flag = 1;
-    while ((Char = *At++))
+    for (int PaddingIndex = 0; PaddingIndex < SIMD_LABEL_PADDING; ++PaddingIndex)
     {
-        struct trie_node *Child = TrieFindChild(TrieNode, Char);
-        if (Child)
+        Labels[NodeCount + PaddingIndex] = 0;
+    }
+    for (uint32_t NodeIndex = NodeCount; NodeIndex--;)
+    {
+        uint32_t Summary = TrieTerminal(Nodes + NodeIndex) ? 0 : NODE_SUMMARY_EMPTY;
+        for (struct trie_node *Child = TrieFirstChild(Nodes + NodeIndex); Child; Child = TrieSibling(Child))
         {
-            Buffer[Length] = Char;
-            SolveSpellingBee_(SolutionBuilder, LetterBank, Child, Mask | Flag, Buffer, Length + 1, CoreMask);
+            Summary = MergeNodeSummary(Summary, Child->Value & 0x7F, Summaries[Child - Nodes]);
         }
-        Flag = Flag << 1;
+        Summaries[NodeIndex] = Summary;
     }
 }
 
-static struct trie_builder BuildTrieFromLexicon(struct memory_arena *Arena, char *Lexicon)
+struct trie_node *LoadTrieImage(void *Image, size_t Size)
 {
-    struct trie_builder Builder = {0};
-    Builder.Stream = Lexicon;
-    Builder.Arena.Size = 32 * 1024 * 1024;
-    Builder.Arena.Memory = ArenaPush(Arena, Builder.Arena.Size);
-    BuildTrie(&Builder);
-    return Builder;
+    struct trie_node *Result = 0;
+    struct trie_image_header *Header = (struct trie_image_header *)Image;
+    if (Header && sizeof(*Header) <= Size &&
+        Header->Magic == TRIE_IMAGE_MAGIC &&
+        Header->Version == TRIE_IMAGE_VERSION &&
+        0 < Header->NodeCount &&
+        sizeof(*Header) + (size_t)Header->NodeCount*(sizeof(struct trie_node) + sizeof(uint32_t) + 1) + SIMD_LABEL_PADDING <= Size)
+    {
+        Result = (struct trie_node *)(Header + 1);
+    }
+    return Result;
 }
 
-struct spelling_bee_solution_builder *SolveSpellingBee(char *Memory, size_t Size, char *Lexicon, char *SortedLetterBank, int CoreMask)
+static uint32_t *TrieImageSummaries(struct trie_node *Root)
 {
-    struct memory_arena Arena = {0};
-    Arena.Size = Size;
-    Arena.Memory = Memory;
+    return (uint32_t *)(Root + ((struct trie_image_header *)Root - 1)->NodeCount);
+}
+
+static uint8_t *TrieImageLabels(struct trie_node *Root)
+{
+    return (uint8_t *)(TrieImageSummaries(Root) + ((struct trie_image_header *)Root - 1)->NodeCount);
+}
+
+#include "nyt_dawg.c"
+
+enum dictionary_kind
+{
+    dictionary_kind_Trie,
+    dictionary_kind_Dawg,
+};
+
+typedef uint32_t dictionary_node;
+
+struct dictionary
+{
+    enum dictionary_kind Kind;
+    struct trie_node *Trie;
+    uint8_t *TrieLabels;
+    struct dawg Dawg;
+    uint32_t *Summaries;
+};
+
+static inline dictionary_node DictionaryFindChild(struct dictionary *Dictionary, dictionary_node Node, char Char)
+{
+    dictionary_node Result = 0;
+    switch (Dictionary->Kind)
+    {
+        case dictionary_kind_Trie:
+        {
+            if (Dictionary->TrieLabels)
+            {
+                int32_t FirstChild = Dictionary->Trie[Node].FirstChild;
+                int ChildIndex = FirstChild ? FindChildLabel(Dictionary->TrieLabels + Node + FirstChild, Char) : -1;
+                PROFILE_COUNT(TrieFindChildCalls, 1);
+                PROFILE_COUNT(TrieNodesTouched, 1);
+                if (0 <= ChildIndex)
+                {
+                    Result = Node + FirstChild + ChildIndex;
+                }
+            }
+            else
+            {
+                struct trie_node *Child = TrieFindChild(Dictionary->Trie + Node, Char);
+                if (Child)
+                {
+                    Result = (dictionary_node)(Child - Dictionary->Trie);
+                }
+            }
+        } break;
+
+        case dictionary_kind_Dawg:
+        {
+            Result = DawgFindChild(&Dictionary->Dawg, Node, Char);
+            PROFILE_COUNT(DawgFindChildCalls, 1);
+        } break;
+    }
+    return Result;
+}
+
+static inline char DictionaryTerminal(struct dictionary *Dictionary, dictionary_node Node)
+{
+    char Result = 0;
+    switch (Dictionary->Kind)
+    {
+        case dictionary_kind_Trie:
+        {
+            Result = TrieTerminal(Dictionary->Trie + Node) != 0;
+        } break;
+
+        case dictionary_kind_Dawg:
+        {
+            Result = DawgTerminal(&Dictionary->Dawg, Node);
+        } break;
+    }
+    return Result;
+}
+
+static inline uint32_t DictionaryChildLetters(struct dictionary *Dictionary, dictionary_node Node)
+{
+    uint32_t Result = 0;
+    switch (Dictionary->Kind)
+    {
+        case dictionary_kind_Trie:
+        {
+            for (struct trie_node *Child = TrieFirstChild(Dictionary->Trie + Node); Child; Child = TrieSibling(Child))
+            {
+                uint32_t Letter = (uint32_t)((Child->Value & 0x7F) - 'A');
+                Result |= Letter < 26 ? 1u << Letter : 0;
+            }
+        } break;
+
+        case dictionary_kind_Dawg:
+        {
+            Result = Dictionary->Dawg.Nodes[Node].ChildMask & DAWG_LETTER_BITS;
+        } break;
+    }
+    return Result;
+}
+
+static inline struct dictionary TrieDictionary(struct trie_node *Root)
+{
+    struct dictionary Result = {0};
+    Result.Kind = dictionary_kind_Trie;
+    Result.Trie = Root;
+    return Result;
+}
+
+static inline struct dictionary TrieImageDictionary(struct trie_node *Root)
+{
+    struct dictionary Result = TrieDictionary(Root);
+    Result.TrieLabels = TrieImageLabels(Root);
+    Result.Summaries = TrieImageSummaries(Root);
+    GetSimdLevel();
+    return Result;
+}
+
+static inline struct dictionary DawgDictionary(struct dawg Dawg)
+{
+    struct dictionary Result = {0};
+    Result.Kind = dictionary_kind_Dawg;
+    Result.Dawg = Dawg;
+    Result.Summaries = Dawg.Summaries;
+    return Result;
+}
+
+int CountSetBits(uint64_t Integer)
+{
+    unsigned int Result = 0;
+    while (Integer > 0)
+    {
+        Integer &= (Integer - 1);
+        Result++;
+    }
+    return Result;
+}
+
+typedef void combination_callback(void *Context, struct solution *Solutions, int *Indices, int Count);
+
+enum combine_mode
+{
+    combine_mode_All,
+    combine_mode_Maximal,
+    combine_mode_Full,
+};
+
+struct combiner
+{
+    struct solution *Solutions;
+    size_t SolutionCount;
+    enum combine_mode Mode;
+    combination_callback *Callback;
+    void *Context;
+    size_t CombinationCount;
+    size_t NodesVisited;
+    int LastCoveringIndex[PUZZLE_MAX_CELLS];
+    struct combination Combination;
+};
+
+struct combine_memo_table
+{
+    struct memory_arena *Arena;
+    struct solution *Solutions;
+    int *CellSolutions;
+    int CellFirst[PUZZLE_MAX_CELLS + 1];
+    struct combine_memo *Slots;
+    size_t SlotMask;
+    size_t EntryCount;
+    size_t Lookups;
+    size_t Hits;
+    size_t NodesVisited;
+};
+
+struct exact_cover
+{
+    struct solution *Solutions;
+    int *CellSolutions;
+    int CellFirst[PUZZLE_MAX_CELLS + 1];
+    char *Spangrams;
+    char RequireSpangram;
+    combination_callback *Callback;
+    void *Context;
+    size_t CoverCount;
+    size_t NodesVisited;
+    int Count;
+    int Indices[MAX_WORDS];
+};
+
+static inline uint64_t MaskZero64(void)
+{
+    return 0;
+}
+
+static inline uint64_t MaskCell64(int CellIndex)
+{
+    return (uint64_t)1 << CellIndex;
+}
+
+static inline uint64_t MaskOr64(uint64_t A, uint64_t B)
+{
+    return A | B;
+}
+
+static inline uint64_t MaskAndNot64(uint64_t A, uint64_t B)
+{
+    return A & ~B;
+}
+
+static inline char MaskIntersects64(uint64_t A, uint64_t B)
+{
+    return (A & B) != 0;
+}
+
+static inline char MaskEquals64(uint64_t A, uint64_t B)
+{
+    return A == B;
+}
+
+static inline char MaskAny64(uint64_t A)
+{
+    return A != 0;
+}
+
+static inline int MaskCount64(uint64_t A)
+{
+    return __builtin_popcountll(A);
+}
+
+static inline int MaskFirst64(uint64_t A)
+{
+    return __builtin_ctzll(A);
+}
+
+static inline uint64_t MaskRest64(uint64_t A)
+{
+    return A & (A - 1);
+}
+
+static inline uint32_t MaskHash64(uint32_t Hash, uint64_t A)
+{
+    Hash = (Hash ^ (uint32_t)A) * 16777619u;
+    return (Hash ^ (uint32_t)(A >> 32)) * 16777619u;
+}
+
+static inline uint64_t SolutionMask64(struct solution *Solution)
+{
+    return Solution->PuzzleMask;
+}
+
+static inline void StoreSolutionMask64(struct memory_arena *Arena, struct solution *Solution, uint64_t Mask)
+{
+    (void)Arena;
+    Solution->PuzzleMask = Mask;
+}
+
+static inline uint64_t MemoMask64(struct combine_memo *Memo)
+{
+    return Memo->PuzzleMask;
+}
+
+static inline void StoreMemoMask64(struct memory_arena *Arena, struct combine_memo *Memo, uint64_t Mask)
+{
+    (void)Arena;
+    Memo->PuzzleMask = Mask;
+}
+
+static inline struct cell_mask MaskZeroWide(void)
+{
+    struct cell_mask Result;
+    for (int WordIndex = 0; WordIndex < CELL_MASK_WORDS; ++WordIndex)
+    {
+        Result.Words[WordIndex] = 0;
+    }
+    return Result;
+}
+
+static inline struct cell_mask MaskCellWide(int CellIndex)
+{
+    struct cell_mask Result = MaskZeroWide();
+    Result.Words[CellIndex / 64] = (uint64_t)1 << (CellIndex % 64);
+    return Result;
+}
+
+static inline struct cell_mask MaskOrWide(struct cell_mask A, struct cell_mask B)
+{
+    for (int WordIndex = 0; WordIndex < CELL_MASK_WORDS; ++WordIndex)
+    {
+        A.Words[WordIndex] |= B.Words[WordIndex];
+    }
+    return A;
+}
+
+static inline struct cell_mask MaskAndNotWide(struct cell_mask A, struct cell_mask B)
+{
+    for (int WordIndex = 0; WordIndex < CELL_MASK_WORDS; ++WordIndex)
+    {
+        A.Words[WordIndex] &= ~B.Words[WordIndex];
+    }
+    return A;
+}
+
+static inline char MaskIntersectsWide(struct cell_mask A, struct cell_mask B)
+{
+    uint64_t Result = 0;
+    for (int WordIndex = 0; WordIndex < CELL_MASK_WORDS; ++WordIndex)
+    {
+        Result |= A.Words[WordIndex] & B.Words[WordIndex];
+    }
+    return Result != 0;
+}
+
+static inline char MaskEqualsWide(struct cell_mask A, struct cell_mask B)
+{
+    uint64_t Result = 0;
+    for (int WordIndex = 0; WordIndex < CELL_MASK_WORDS; ++WordIndex)
+    {
+        Result |= A.Words[WordIndex] ^ B.Words[WordIndex];
+    }
+    return Result == 0;
+}
+
+static inline char MaskAnyWide(struct cell_mask A)
+{
+    uint64_t Result = 0;
+    for (int WordIndex = 0; WordIndex < CELL_MASK_WORDS; ++WordIndex)
+    {
+        Result |= A.Words[WordIndex];
+    }
+    return Result != 0;
+}
+
+static inline int MaskCountWide(struct cell_mask A)
+{
+    int Result = 0;
+    for (int WordIndex = 0; WordIndex < CELL_MASK_WORDS; ++WordIndex)
+    {
+        Result += __builtin_popcountll(A.Words[WordIndex]);
+    }
+    return Result;
+}
+
+static inline int MaskFirstWide(struct cell_mask A)
+{
+    int WordIndex = 0;
+    while (!A.Words[WordIndex])
+    {
+        WordIndex++;
+    }
+    return WordIndex*64 + __builtin_ctzll(A.Words[WordIndex]);
+}
+
+static inline struct cell_mask MaskRestWide(struct cell_mask A)
+{
+    int WordIndex = 0;
+    while (!A.Words[WordIndex])
+    {
+        WordIndex++;
+    }
+    A.Words[WordIndex] &= A.Words[WordIndex] - 1;
+    return A;
+}
+
+static inline uint32_t MaskHashWide(uint32_t Hash, struct cell_mask A)
+{
+    for (int WordIndex = 0; WordIndex < CELL_MASK_WORDS; ++WordIndex)
+    {
+        Hash = MaskHash64(Hash, A.Words[WordIndex]);
+    }
+    return Hash;
+}
+
+static inline struct cell_mask SolutionMaskWide(struct solution *Solution)
+{
+    return *Solution->Cells;
+}
+
+static inline void StoreSolutionMaskWide(struct memory_arena *Arena, struct solution *Solution, struct cell_mask Mask)
+{
+    Solution->Cells = (struct cell_mask *)ArenaPushAligned(Arena, sizeof(struct cell_mask), sizeof(uint64_t));
+    *Solution->Cells = Mask;
+}
+
+static inline struct cell_mask MemoMaskWide(struct combine_memo *Memo)
+{
+    return *Memo->Cells;
+}
+
+static inline void StoreMemoMaskWide(struct memory_arena *Arena, struct combine_memo *Memo, struct cell_mask Mask)
+{
+    Memo->Cells = (struct cell_mask *)ArenaPushAligned(Arena, sizeof(struct cell_mask), sizeof(uint64_t));
+    *Memo->Cells = Mask;
+}
+
+#define STRANDS_SUFFIX Fixed
+#define STRANDS_MASK_SUFFIX 64
+#define STRANDS_MASK uint64_t
+#define STRANDS_GEOMETRY struct narrow_geometry
+#define STRANDS_GEOMETRY_OF(Puzzle) (&(Puzzle)->Narrow)
+#define STRANDS_FULL_MASK(Puzzle) FULL_PUZZLE_MASK
+#define STRANDS_CELL_COUNT(Puzzle) PUZZLE_SIZE
+#include "nyt_strands.c"
+
+#define STRANDS_SUFFIX Narrow
+#define STRANDS_MASK_SUFFIX 64
+#define STRANDS_MASK uint64_t
+#define STRANDS_GEOMETRY struct narrow_geometry
+#define STRANDS_GEOMETRY_OF(Puzzle) (&(Puzzle)->Narrow)
+#define STRANDS_FULL_MASK(Puzzle) ((Puzzle)->Narrow.FullMask)
+#define STRANDS_CELL_COUNT(Puzzle) ((Puzzle)->CellCount)
+#include "nyt_strands.c"
+
+#define STRANDS_SUFFIX Wide
+#define STRANDS_MASK_SUFFIX Wide
+#define STRANDS_MASK struct cell_mask
+#define STRANDS_GEOMETRY struct wide_geometry
+#define STRANDS_GEOMETRY_OF(Puzzle) (&(Puzzle)->Wide)
+#define STRANDS_FULL_MASK(Puzzle) ((Puzzle)->Wide.FullMask)
+#define STRANDS_CELL_COUNT(Puzzle) ((Puzzle)->CellCount)
+#include "nyt_strands.c"
+
+void SolveStrandsCell(struct strands_puzzle *Puzzle, int CellIndex, struct dictionary *Dictionary, struct solution_builder *Builder)
+{
+    PROFILE_BLOCK_BEGIN(SolveStrandsCell);
+    switch (Puzzle->Board)
+    {
+        case strands_board_Fixed: SolveStrandsCellFixed(Puzzle, CellIndex, Dictionary, Builder); break;
+        case strands_board_Narrow: SolveStrandsCellNarrow(Puzzle, CellIndex, Dictionary, Builder); break;
+        case strands_board_Wide: SolveStrandsCellWide(Puzzle, CellIndex, Dictionary, Builder); break;
+    }
+    PROFILE_BLOCK_END(SolveStrandsCell);
+}
 
+void DeduplicateSolutions(struct strands_puzzle *Puzzle, struct solution_builder *Builder, struct memory_arena *TempArena)
+{
+    PROFILE_BLOCK_BEGIN(DeduplicateSolutions);
+    switch (Puzzle->Board)
+    {
+        case strands_board_Fixed: DeduplicateSolutionsFixed(Builder, TempArena); break;
+        case strands_board_Narrow: DeduplicateSolutionsNarrow(Builder, TempArena); break;
+        case strands_board_Wide: DeduplicateSolutionsWide(Builder, TempArena); break;
+    }
+    PROFILE_BLOCK_END(DeduplicateSolutions);
+}
+
+size_t Combine(struct strands_puzzle *Puzzle, struct solution_builder *Builder, enum combine_mode Mode, combination_callback *Callback, void *Context)
+{
+    size_t Result = 0;
+    PROFILE_BLOCK_BEGIN(Combine);
+    switch (Puzzle->Board)
+    {
+        case strands_board_Fixed: Result = CombineFixed(Puzzle, Builder, Mode, Callback, Context); break;
+        case strands_board_Narrow: Result = CombineNarrow(Puzzle, Builder, Mode, Callback, Context); break;
+        case strands_board_Wide: Result = CombineWide(Puzzle, Builder, Mode, Callback, Context); break;
+    }
+    PROFILE_BLOCK_END(Combine);
+    return Result;
+}
+
+uint64_t CombineMemoized(struct memory_arena *TempArena, struct strands_puzzle *Puzzle, struct solution_builder *Builder, struct combine_summary *Summary)
+{
+    uint64_t Result = 0;
+    PROFILE_BLOCK_BEGIN(CombineMemoized);
+    switch (Puzzle->Board)
+    {
+        case strands_board_Fixed: Result = CombineMemoizedFixed(TempArena, Puzzle, Builder, Summary); break;
+        case strands_board_Narrow: Result = CombineMemoizedNarrow(TempArena, Puzzle, Builder, Summary); break;
+        case strands_board_Wide: Result = CombineMemoizedWide(TempArena, Puzzle, Builder, Summary); break;
+    }
+    PROFILE_BLOCK_END(CombineMemoized);
+    return Result;
+}
+
+size_t ExactCover(struct memory_arena *TempArena, struct strands_puzzle *Puzzle, struct solution_builder *Builder, char RequireSpangram, combination_callback *Callback, void *Context)
+{
+    size_t Result = 0;
+    PROFILE_BLOCK_BEGIN(ExactCover);
+    switch (Puzzle->Board)
+    {
+        case strands_board_Fixed: Result = ExactCoverFixed(TempArena, Puzzle, Builder, RequireSpangram, Callback, Context); break;
+        case strands_board_Narrow: Result = ExactCoverNarrow(TempArena, Puzzle, Builder, RequireSpangram, Callback, Context); break;
+        case strands_board_Wide: Result = ExactCoverWide(TempArena, Puzzle, Builder, RequireSpangram, Callback, Context); break;
+    }
+    PROFILE_BLOCK_END(ExactCover);
+    return Result;
+}
+
+int BuildStrandsPuzzle(struct strands_puzzle *Puzzle, int Width, int Height)
+{
+    int Result = 0;
+    if (0 < Width && 0 < Height && Width*Height <= PUZZLE_MAX_CELLS)
+    {
+        Puzzle->Width = Width;
+        Puzzle->Height = Height;
+        Puzzle->CellCount = Result = Width*Height;
+        if (Width == PUZZLE_WIDTH && Height == PUZZLE_HEIGHT && Puzzle->Unknown != unknown_cells_Blocked)
+        {
+            Puzzle->Board = strands_board_Fixed;
+            BuildBoardGeometryFixed(Puzzle);
+        }
+        else if (Puzzle->CellCount <= 64)
+        {
+            Puzzle->Board = strands_board_Narrow;
+            BuildBoardGeometryNarrow(Puzzle);
+        }
+        else
+        {
+            Puzzle->Board = strands_board_Wide;
+            BuildBoardGeometryWide(Puzzle);
+        }
+    }
+    return Result;
+}
+
+int ParseStrandsPuzzle(char *Contents, size_t Size, struct strands_puzzle *Puzzle)
+{
+    int Width = 0;
+    int Height = 0;
+    int CellCount = 0;
+    int RowLength = 0;
+    char Valid = 1;
+    char *End = Contents + Size;
+    for (char *At = Contents; Valid && At <= End; ++At)
+    {
+        char Char = At < End ? *At : '\n';
+        if (Char == '\n' || Char == '/')
+        {
+            if (RowLength)
+            {
+                Valid = !Width || RowLength == Width;
+                Width = RowLength;
+                Height++;
+                RowLength = 0;
+            }
+        }
+        else if (Char != '\r' && Char != ' ' && Char != '\t')
+        {
+            if ('a' <= Char && Char <= 'z')
+            {
+                Char = 'A' + (Char - 'a');
+            }
+            Valid = CellCount < PUZZLE_MAX_CELLS;
+            if (Valid)
+            {
+                Puzzle->Letters[CellCount++] = Char;
+                RowLength++;
+            }
+        }
+    }
+    if (Height == 1 && Width == PUZZLE_SIZE)
+    {
+        Width = PUZZLE_WIDTH;
+        Height = PUZZLE_HEIGHT;
+    }
+    Puzzle->Unknown = unknown_cells_Literal;
+    Puzzle->MaxWildcards = 0;
+    return Valid ? BuildStrandsPuzzle(Puzzle, Width, Height) : 0;
+}
+
+int SetStrandsUnknownCells(struct strands_puzzle *Puzzle, enum unknown_cells Unknown, int MaxWildcards)
+{
+    Puzzle->Unknown = Unknown;
+    Puzzle->MaxWildcards = Unknown == unknown_cells_Wildcard ? MaxWildcards : 0;
+    return BuildStrandsPuzzle(Puzzle, Puzzle->Width, Puzzle->Height);
+}
+
+struct strands_cell_result
+{
+    int WorkerIndex;
+    size_t FirstSolution;
+    size_t SolutionCount;
+};
+
+struct strands_job
+{
+    struct strands_puzzle *Puzzle;
+    struct dictionary *Dictionary;
+    int NextCell;
+    struct strands_cell_result Cells[PUZZLE_MAX_CELLS];
+};
+
+void RunStrandsJob(struct strands_job *Job, int WorkerIndex, struct solution_builder *Builder)
+{
+    int CellIndex;
+    while ((CellIndex = __atomic_fetch_add(&Job->NextCell, 1, __ATOMIC_RELAXED)) < Job->Puzzle->CellCount)
+    {
+        struct strands_cell_result *Cell = Job->Cells + CellIndex;
+        Cell->WorkerIndex = WorkerIndex;
+        Cell->FirstSolution = Builder->SolutionCount;
+        SolveStrandsCell(Job->Puzzle, CellIndex, Job->Dictionary, Builder);
+        Cell->SolutionCount = Builder->SolutionCount - Cell->FirstSolution;
+    }
+    PROFILE_FLUSH();
+}
+
+void GatherStrandsJob(struct strands_job *Job, struct solution **WorkerSolutions, struct solution_builder *Builder)
+{
+    for (int CellIndex = 0; CellIndex < Job->Puzzle->CellCount; ++CellIndex)
+    {
+        struct strands_cell_result Cell = Job->Cells[CellIndex];
+        struct solution *Source = WorkerSolutions[Cell.WorkerIndex] + Cell.FirstSolution;
+        for (size_t SolutionIndex = 0; SolutionIndex < Cell.SolutionCount; ++SolutionIndex)
+        {
+            *PushStruct(&Builder->SolutionArena, solution) = Source[SolutionIndex];
+            Builder->SolutionCount++;
+        }
+    }
+}
+
+enum nyt_game
+{
+    nyt_game_Strands,
+    nyt_game_SpellingBee,
+};
+
+#define PANGRAM_BITS 0x7F
+
+void SolveSpellingBee_(struct spelling_bee_solution_builder *SolutionBuilder, char *LetterBank, struct dictionary *Dictionary, dictionary_node Node, char Mask, char *Buffer, int Length, int CoreMask)
+{
+    char *At = LetterBank;
+    SolutionBuilder->NodesVisited++;
+    PROFILE_COUNT(SpellingBeeCalls, 1);
+    if (DictionaryTerminal(Dictionary, Node) && (Mask & CoreMask) == CoreMask && 4 <= Length)
+    {
+        struct spelling_bee_solution *Solution = PushStruct(&SolutionBuilder->SolutionArena, spelling_bee_solution);
+        Solution->Mask = Mask;
+        Solution->Length = Length;
+        Solution->Word = ArenaPush(&SolutionBuilder->StringArena, Length);
+        Copy(Solution->Word, Buffer, Length);
+        SolutionBuilder->SolutionCount++;
+    }
+    char Char;
+    int Flag = 1;
+    while ((Char = *At++))
+    {
+        dictionary_node Child = DictionaryFindChild(Dictionary, Node, Char);
+        if (Child)
+        {
+            Buffer[Length] = Char;
+            SolveSpellingBee_(SolutionBuilder, LetterBank, Dictionary, Child, Mask | Flag, Buffer, Length + 1, CoreMask);
+        }
+        Flag = Flag << 1;
+    }
+}
+
+int ParseSpellingBeeLetterBank(char *LetterBank, size_t Length, char *SortedLetterBank, int *CoreMask)
+{
+    char Seen[26] = {0};
+    int LetterCount = 0;
+    char CoreChar = 0;
+    for (size_t CharIndex = 0; CharIndex < Length; ++CharIndex)
+    {
+        char Char = LetterBank[CharIndex];
+        if ('a' <= Char && Char <= 'z')
+        {
+            Char = 'A' + (Char - 'a');
+        }
+        if (!('A' <= Char && Char <= 'Z') || Seen[Char - 'A'])
+        {
+            return 0;
+        }
+        if (!LetterCount)
+        {
+            CoreChar = Char;
+        }
+        Seen[Char - 'A'] = 1;
+        LetterCount++;
+    }
+    if (LetterCount != SPELLING_BEE_LETTER_BANK_SIZE)
+    {
+        return 0;
+    }
+
+    char *Dest = SortedLetterBank;
+    for (int Letter = 0; Letter < 26; ++Letter)
+    {
+        if (Seen[Letter])
+        {
+            if ('A' + Letter == CoreChar)
+            {
+                *CoreMask = 1 << (Dest - SortedLetterBank);
+            }
+            *Dest++ = 'A' + Letter;
+        }
+    }
+    *Dest = 0;
+    return 1;
+}
+
+static struct trie_builder BuildTrieFromLexicon(struct memory_arena *Arena, char *Lexicon, size_t Size)
+{
+    struct trie_builder Builder = {0};
+    Builder.Reader = BeginLexicon(Lexicon, Size);
+    Builder.Arena = SubArena(Arena, TRIE_BUILDER_ARENA_SIZE, "trie");
+    BuildTrie(&Builder);
+    return Builder;
+}
+
+#include "nyt_bee.c"
+
+struct spelling_bee_solution_builder *SolveSpellingBeeWithDictionary(struct memory_arena *Arena, struct dictionary *Dictionary, char *SortedLetterBank, int CoreMask)
+{
     char Buffer[256];
-    struct spelling_bee_solution_builder *SolutionBuilder = PushStruct(&Arena, spelling_bee_solution_builder);
-    struct trie_builder Builder = BuildTrieFromLexicon(&Arena, Lexicon);
+    struct spelling_bee_solution_builder *SolutionBuilder = PushStruct(Arena, spelling_bee_solution_builder);
     SolutionBuilder->SolutionCount = 0;
-    SolutionBuilder->StringArena.Size = 16*1024;
-    SolutionBuilder->StringArena.Memory = ArenaPush(&Arena, SolutionBuilder->StringArena.Size);
-    SolutionBuilder->SolutionArena.Size = 16*1024;
-    SolutionBuilder->SolutionArena.Memory = ArenaPush(&Arena, SolutionBuilder->SolutionArena.Size);
+    SolutionBuilder->NodesVisited = 0;
+    SolutionBuilder->StringArena = SubArena(Arena, 256*1024, "bee strings");
+    SolutionBuilder->SolutionArena = SubArena(Arena, 256*1024, "bee solutions");
 
-    SolveSpellingBee_(SolutionBuilder, SortedLetterBank, &Builder.Root, 0, Buffer, 0, CoreMask);
+    PROFILE_BLOCK_BEGIN(SolveSpellingBee);
+    SolveSpellingBee_(SolutionBuilder, SortedLetterBank, Dictionary, 0, 0, Buffer, 0, CoreMask);
+    PROFILE_BLOCK_END(SolveSpellingBee);
     return SolutionBuilder;
 }
+
+#define SPELLING_BEE_BATCH_SIZE 64
+
+struct spelling_bee_session
+{
+    void *Image;
+    size_t ImageSize;
+    struct spelling_bee_solution Batch[SPELLING_BEE_BATCH_SIZE];
+    struct memory_arena Arena;
+    struct bee_index Index;
+    struct spelling_bee_cursor Cursor;
+    char SortedLetterBank[SPELLING_BEE_LETTER_BANK_SIZE + 1];
+};
+
+struct spelling_bee_session *CreateSpellingBeeSession(char *Memory, size_t Size)
+{
+    struct memory_arena Arena = {0};
+    Arena.Size = Size;
+    Arena.Memory = Memory;
+    Arena.Flags = arena_flag_FailHard;
+    struct spelling_bee_session *Session = PushStruct(&Arena, spelling_bee_session);
+    Session->Image = 0;
+    Session->ImageSize = 0;
+    Session->Index.Slots = 0;
+    Session->Cursor.MatchCount = 0;
+    Session->Cursor.MatchIndex = 0;
+    Session->Arena = Arena;
+    return Session;
+}
+
+char *PushSpellingBeeInput(struct spelling_bee_session *Session, size_t Size)
+{
+    return (char *)ArenaPushAligned(&Session->Arena, Size, sizeof(uint64_t));
+}
+
+int LoadSpellingBeeImage(struct spelling_bee_session *Session, char *Image, size_t Size)
+{
+    Session->Index = LoadBeeIndexImage(Image, Size);
+    Session->Image = Image;
+    Session->ImageSize = Size;
+    return Session->Index.Slots != 0;
+}
+
+int BuildSpellingBeeImage(struct spelling_bee_session *Session, char *Lexicon, size_t LexiconSize)
+{
+    struct bee_index Index = BuildBeeIndex(&Session->Arena, Lexicon, LexiconSize);
+    size_t ImageSize = BeeIndexImageSize(&Index);
+    char *Image = PushSpellingBeeInput(Session, ImageSize);
+    WriteBeeIndexImage(&Index, Image);
+    return LoadSpellingBeeImage(Session, Image, ImageSize);
+}
+
+int BeginSpellingBeeSolve(struct spelling_bee_session *Session, uint32_t LetterMask, int CoreLetter)
+{
+    int Result = 0;
+    Session->Cursor.MatchCount = 0;
+    Session->Cursor.MatchIndex = 0;
+    if (Session->Index.Slots &&
+        __builtin_popcount(LetterMask & ((1u << 26) - 1)) == SPELLING_BEE_LETTER_BANK_SIZE &&
+        0 <= CoreLetter && CoreLetter < 26 && (LetterMask & (1u << CoreLetter)))
+    {
+        int CoreMask = 1 << __builtin_popcount(LetterMask & ((1u << CoreLetter) - 1));
+        char *Dest = Session->SortedLetterBank;
+        for (uint32_t Letters = LetterMask; Letters; Letters &= Letters - 1)
+        {
+            *Dest++ = 'A' + __builtin_ctz(Letters);
+        }
+        *Dest = 0;
+        BeginSpellingBeeCursor(&Session->Cursor, &Session->Index, Session->SortedLetterBank, CoreMask);
+        Result = 1;
+    }
+    return Result;
+}
+
+size_t StepSpellingBeeSolve(struct spelling_bee_session *Session)
+{
+    return StepSpellingBeeCursor(&Session->Cursor, &Session->Index, Session->Batch, SPELLING_BEE_BATCH_SIZE);
+}
+
+#define STRANDS_BOARD_TEXT_SIZE (4*PUZZLE_MAX_CELLS)
+
+struct strands_session
+{
+    struct solution *Solutions;
+    size_t SolutionCount;
+    struct combination *Covers;
+    size_t CoverCount;
+    size_t TotalCoverCount;
+    void *Image;
+    size_t ImageSize;
+    enum strands_board Board;
+    int Width;
+    int Height;
+    char BoardText[STRANDS_BOARD_TEXT_SIZE];
+    int WorkerCount;
+    size_t MaxCovers;
+    struct memory_arena Arena;
+    struct temporary_memory SolveStart;
+    struct dictionary Dictionary;
+    struct strands_puzzle Puzzle;
+    struct strands_job Job;
+    struct solution_builder Builder;
+    struct solution_builder *WorkerBuilders;
+};
+
+struct strands_session *CreateStrandsSession(char *Memory, size_t Size)
+{
+    struct memory_arena Arena = {0};
+    Arena.Size = Size;
+    Arena.Memory = Memory;
+    Arena.Flags = arena_flag_FailHard;
+    struct strands_session *Session = PushStruct(&Arena, strands_session);
+    Session->SolutionCount = 0;
+    Session->CoverCount = 0;
+    Session->TotalCoverCount = 0;
+    Session->Image = 0;
+    Session->ImageSize = 0;
+    Session->Dictionary.Dawg.NodeCount = 0;
+    Session->Arena = Arena;
+    Session->SolveStart = BeginTemporaryMemory(&Session->Arena);
+    return Session;
+}
+
+char *PushStrandsInput(struct strands_session *Session, size_t Size)
+{
+    return (char *)ArenaPushAligned(&Session->Arena, Size, sizeof(uint64_t));
+}
+
+int LoadStrandsImage(struct strands_session *Session, char *Image, size_t Size)
+{
+    Session->Dictionary = DawgDictionary(LoadDawgImage(Image, Size));
+    Session->Image = Image;
+    Session->ImageSize = Size;
+    Session->SolveStart = BeginTemporaryMemory(&Session->Arena);
+    return Session->Dictionary.Dawg.NodeCount != 0;
+}
+
+int BuildStrandsImage(struct strands_session *Session, char *Lexicon, size_t LexiconSize)
+{
+    struct temporary_memory Temporary = BeginTemporaryMemory(&Session->Arena);
+    struct trie_builder Trie = BuildTrieFromLexicon(&Session->Arena, Lexicon, LexiconSize);
+    struct dawg Dawg = BuildDawgFromTrie(&Session->Arena, Trie.Root, Trie.NodeCount);
+    size_t ImageSize = DawgImageSize(&Dawg);
+    char *Image = PushStrandsInput(Session, ImageSize);
+    WriteDawgImage(&Dawg, Image);
+    EndTemporaryMemory(Temporary);
+
+    char *Dest = PushStrandsInput(Session, ImageSize);
+    Copy(Dest, Image, ImageSize);
+    return LoadStrandsImage(Session, Dest, ImageSize);
+}
+
+int BeginStrandsSolve(struct strands_session *Session, size_t BoardSize, int WorkerCount, size_t WorkerArenaSize)
+{
+    int Result = 0;
+    EndTemporaryMemory(Session->SolveStart);
+    Session->SolutionCount = 0;
+    Session->CoverCount = 0;
+    Session->TotalCoverCount = 0;
+    if (Session->Dictionary.Dawg.NodeCount && 0 < WorkerCount && BoardSize <= STRANDS_BOARD_TEXT_SIZE &&
+        ParseStrandsPuzzle(Session->BoardText, BoardSize, &Session->Puzzle))
+    {
+        struct strands_puzzle *Puzzle = &Session->Puzzle;
+        Session->Board = Puzzle->Board;
+        Session->Width = Puzzle->Width;
+        Session->Height = Puzzle->Height;
+        Session->Job.Puzzle = Puzzle;
+        Session->Job.Dictionary = &Session->Dictionary;
+        Session->Job.NextCell = 0;
+        Session->WorkerCount = WorkerCount;
+        Session->WorkerBuilders = PushArray(&Session->Arena, WorkerCount, struct solution_builder);
+        for (int WorkerIndex = 0; WorkerIndex < WorkerCount; ++WorkerIndex)
+        {
+            struct solution_builder Builder = {0};
+            Builder.StringArena = SubArena(&Session->Arena, WorkerArenaSize, "worker strings");
+            Builder.SolutionArena = SubArena(&Session->Arena, WorkerArenaSize, "worker solutions");
+            Session->WorkerBuilders[WorkerIndex] = Builder;
+        }
+        Result = Puzzle->CellCount;
+    }
+    return Result;
+}
+
+void RunStrandsWorker(struct strands_session *Session, int WorkerIndex)
+{
+    RunStrandsJob(&Session->Job, WorkerIndex, Session->WorkerBuilders + WorkerIndex);
+}
+
+static void KeepStrandsCover(void *Context, struct solution *Solutions, int *Indices, int Count)
+{
+    struct strands_session *Session = (struct strands_session *)Context;
+    if (Session->CoverCount < Session->MaxCovers)
+    {
+        struct combination *Cover = Session->Covers + Session->CoverCount++;
+        Cover->Count = Count;
+        Copy(Cover->Indices, Indices, Count*sizeof(int));
+    }
+}
+
+size_t FinishStrandsSolve(struct strands_session *Session, int RequireSpangram, size_t MaxCovers)
+{
+    struct memory_arena *Arena = &Session->Arena;
+    struct solution **WorkerSolutions = PushArray(Arena, Session->WorkerCount, struct solution *);
+    size_t SolutionCount = 0;
+    for (int WorkerIndex = 0; WorkerIndex < Session->WorkerCount; ++WorkerIndex)
+    {
+        WorkerSolutions[WorkerIndex] = (struct solution *)Session->WorkerBuilders[WorkerIndex].SolutionArena.Memory;
+        SolutionCount += Session->WorkerBuilders[WorkerIndex].SolutionCount;
+    }
+
+    struct solution_builder Builder = {0};
+    Builder.SolutionArena = SubArena(Arena, SolutionCount*sizeof(struct solution), "solutions");
+    Session->Builder = Builder;
+    GatherStrandsJob(&Session->Job, WorkerSolutions, &Session->Builder);
+    DeduplicateSolutions(&Session->Puzzle, &Session->Builder, Arena);
+    Session->Solutions = (struct solution *)Session->Builder.SolutionArena.Memory;
+    Session->SolutionCount = Session->Builder.SolutionCount;
+
+    Session->MaxCovers = MaxCovers;
+    Session->Covers = PushArray(Arena, MaxCovers, struct combination);
+    if (MaxCovers)
+    {
+        Session->TotalCoverCount = ExactCover(Arena, &Session->Puzzle, &Session->Builder, (char)RequireSpangram, KeepStrandsCover, Session);
+    }
+    return Session->SolutionCount;
+}
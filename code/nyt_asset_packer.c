@@ -1,29 +1,99 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include "nyt.c"
+#include "nyt_posix.c"
+
+#define ASSET_ALIGNMENT 16
+
+static size_t AlignUp(size_t Value, size_t Alignment)
+{
+    return (Value + Alignment - 1) & ~(Alignment - 1);
+}
 
 int main(int ArgCount, char *Args[])
 {
+    if (ArgCount < 3)
+    {
+        printf("usage: %s <executable> <lexicon> [lexicon image]\n", Args[0]);
+        return 1;
+    }
+
     FILE *ExecutableFile = fopen(Args[1], "rb");
     FILE *DataFile = fopen(Args[2], "rb");
+    if (!ExecutableFile || !DataFile)
+    {
+        printf("Failed to open %s\n", ExecutableFile ? Args[2] : Args[1]);
+        return 1;
+    }
 
     fseek(ExecutableFile, 0, SEEK_END);
     size_t ExecutableFileSize = ftell(ExecutableFile);
     fseek(ExecutableFile, 0, SEEK_SET);
-    
+
     fseek(DataFile, 0, SEEK_END);
     size_t DataFileSize = ftell(DataFile);
     fseek(DataFile, 0, SEEK_SET);
 
-    size_t FileSize = ExecutableFileSize + DataFileSize;
-    char *FileContents = malloc(FileSize);
-    char *Dest = FileContents;
-    Dest += fread(Dest, 1, ExecutableFileSize, ExecutableFile);
-    fread(Dest, 1, DataFileSize, DataFile);
+    char *Lexicon = malloc(DataFileSize + 1);
+    fread(Lexicon, 1, DataFileSize, DataFile);
+    Lexicon[DataFileSize] = 0;
+    fclose(DataFile);
+
+    struct memory_arena Arena = ReserveArena(1024*1024*1024, "packer");
+    struct trie_builder Builder = BuildTrieParallel(&Arena, Lexicon, DataFileSize, 0);
+    struct dawg Dawg = BuildDawgFromTrie(&Arena, Builder.Root, Builder.NodeCount);
+    size_t DawgSize = DawgImageSize(&Dawg);
+    struct bee_index BeeIndex = BuildBeeIndex(&Arena, Lexicon, DataFileSize);
+    size_t BeeIndexSize = BeeIndexImageSize(&BeeIndex);
+    size_t LexiconSize = LexiconImageSize(Lexicon, DataFileSize);
+
+    struct packed_assets_header Header = {0};
+    Header.Magic = PACKED_ASSETS_MAGIC;
+    Header.Version = PACKED_ASSETS_VERSION;
+    size_t DataSize = AlignUp(sizeof(Header), ASSET_ALIGNMENT);
+    Header.Assets[packed_asset_Lexicon].Offset = DataSize;
+    Header.Assets[packed_asset_Lexicon].Size = LexiconSize;
+    DataSize = AlignUp(DataSize + LexiconSize, ASSET_ALIGNMENT);
+    Header.Assets[packed_asset_DawgImage].Offset = DataSize;
+    Header.Assets[packed_asset_DawgImage].Size = DawgSize;
+    DataSize = AlignUp(DataSize + DawgSize, ASSET_ALIGNMENT);
+    Header.Assets[packed_asset_BeeIndexImage].Offset = DataSize;
+    Header.Assets[packed_asset_BeeIndexImage].Size = BeeIndexSize;
+    DataSize += BeeIndexSize;
+
+    size_t DataStart = AlignUp(ExecutableFileSize, ASSET_ALIGNMENT);
+    size_t FileSize = DataStart + DataSize;
+    char *FileContents = calloc(FileSize, 1);
+    fread(FileContents, 1, ExecutableFileSize, ExecutableFile);
+    char *Data = FileContents + DataStart;
+    Copy(Data, &Header, sizeof(Header));
+    WriteLexiconImage(Lexicon, DataFileSize, Data + Header.Assets[packed_asset_Lexicon].Offset);
+    WriteDawgImage(&Dawg, Data + Header.Assets[packed_asset_DawgImage].Offset);
+    WriteBeeIndexImage(&BeeIndex, Data + Header.Assets[packed_asset_BeeIndexImage].Offset);
 
     fclose(ExecutableFile);
     ExecutableFile = fopen(Args[1], "wb");
     fwrite(FileContents, 1, FileSize, ExecutableFile);
-    fwrite(&ExecutableFileSize, sizeof(ExecutableFileSize), 1, ExecutableFile);
-    
+    fwrite(&DataStart, sizeof(DataStart), 1, ExecutableFile);
+    fclose(ExecutableFile);
+
+    printf("Packed %zu words (%zu lexicon bytes; %u dawg nodes, %zu bytes; %u bee words, %zu bytes) into %s (%zu bytes)\n",
+           Builder.WordCount, LexiconSize, Dawg.NodeCount, DawgSize, BeeIndex.WordCount, BeeIndexSize, Args[1], FileSize + sizeof(DataStart));
+
+    if (3 < ArgCount)
+    {
+        FILE *LexiconFile = fopen(Args[3], "wb");
+        if (!LexiconFile)
+        {
+            printf("Failed to open %s\n", Args[3]);
+            return 1;
+        }
+        char *LexiconImage = malloc(LexiconSize);
+        WriteLexiconImage(Lexicon, DataFileSize, LexiconImage);
+        fwrite(LexiconImage, 1, LexiconSize, LexiconFile);
+        fclose(LexiconFile);
+        printf("Wrote %zu byte lexicon image to %s\n", LexiconSize, Args[3]);
+    }
+
     return 0;
 }
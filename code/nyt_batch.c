@@ -0,0 +1,559 @@
+#include <dirent.h>
+#include <stdarg.h>
+
+#define BATCH_RECORD_SIZE (64*1024)
+#define BATCH_WORKER_ARENA_SIZE (1024*1024*1024)
+
+struct batch_puzzle
+{
+    char *Name;
+    char *Contents;
+    size_t Size;
+};
+
+struct batch_job
+{
+    enum nyt_game Game;
+    struct dictionary *Dictionary;
+    struct bee_index *BeeIndex;
+    struct result_cache *Cache;
+    char ShowPangrams;
+    int PuzzleCount;
+    int NextPuzzle;
+    struct batch_puzzle *Puzzles;
+    pthread_mutex_t OutputLock;
+};
+
+struct batch_worker
+{
+    pthread_t Thread;
+    struct batch_job *Job;
+    struct memory_arena Arena;
+    struct solution_builder Builder;
+};
+
+struct batch_record
+{
+    char *Memory;
+    size_t Size;
+    size_t Used;
+    char Overflowed;
+};
+
+static void RecordAppend(struct batch_record *Record, char *Format, ...)
+{
+    va_list ArgList;
+    va_start(ArgList, Format);
+    size_t Remaining = Record->Size - Record->Used;
+    int Written = vsnprintf(Record->Memory + Record->Used, Remaining, Format, ArgList);
+    va_end(ArgList);
+    if (0 < Written)
+    {
+        Record->Used += ((size_t)Written < Remaining) ? (size_t)Written : Remaining - 1;
+        Record->Overflowed |= Remaining <= (size_t)Written;
+    }
+}
+
+static void BeginRecord(struct batch_record *Record)
+{
+    Record->Used = 0;
+    Record->Overflowed = 0;
+}
+
+static void EndRecord(struct batch_record *Record, char *Name)
+{
+    if (Record->Overflowed)
+    {
+        BeginRecord(Record);
+        RecordAppend(Record, "%s\terror\tresult too large\n", Name);
+    }
+}
+
+struct first_cover
+{
+    int Found;
+    struct combination Combination;
+};
+
+static void KeepFirstCover(void *Context, struct solution *Solutions, int *Indices, int Count)
+{
+    struct first_cover *First = (struct first_cover *)Context;
+    if (!First->Found++)
+    {
+        First->Combination.Count = Count;
+        Copy(First->Combination.Indices, Indices, Count*sizeof(int));
+    }
+}
+
+static void SolveBatchStrands(struct memory_arena *Arena, struct solution_builder *SolutionBuilder, struct batch_job *Job, struct batch_puzzle *BatchPuzzle, struct batch_record *Record)
+{
+    struct strands_puzzle *Puzzle = PushStruct(Arena, strands_puzzle);
+    if (!ParseStrandsPuzzle(BatchPuzzle->Contents, BatchPuzzle->Size, Puzzle))
+    {
+        RecordAppend(Record, "%s\terror\texpected rows of equal length, at most %d cells\n", BatchPuzzle->Name, PUZZLE_MAX_CELLS);
+        return;
+    }
+
+    char Key[32 + PUZZLE_MAX_CELLS];
+    uint32_t KeySize = (uint32_t)snprintf(Key, sizeof(Key), "s-%dx%d-", Puzzle->Width, Puzzle->Height);
+    KeySize += Copy(Key + KeySize, Puzzle->Letters, Puzzle->CellCount);
+    RecordAppend(Record, "%s", BatchPuzzle->Name);
+    size_t ResultStart = Record->Used;
+    uint32_t CachedSize;
+    char *Cached = Job->Cache ? CacheLookup(Job->Cache, Arena, Key, KeySize, &CachedSize) : 0;
+    if (Cached)
+    {
+        RecordAppend(Record, "%.*s", (int)CachedSize, Cached);
+        return;
+    }
+
+    SolutionBuilder->SolutionCount = 0;
+    ResetArena(&SolutionBuilder->StringArena);
+    ResetArena(&SolutionBuilder->SolutionArena);
+    for (int CellIndex = 0; CellIndex < Puzzle->CellCount; ++CellIndex)
+    {
+        SolveStrandsCell(Puzzle, CellIndex, Job->Dictionary, SolutionBuilder);
+    }
+    DeduplicateSolutions(Puzzle, SolutionBuilder, Arena);
+
+    struct first_cover First = {0};
+    ExactCover(Arena, Puzzle, SolutionBuilder, 0, KeepFirstCover, &First);
+
+    struct solution *Solutions = (struct solution *)SolutionBuilder->SolutionArena.Memory;
+    RecordAppend(Record, "\t%zu\t%d\t", SolutionBuilder->SolutionCount, First.Found);
+    for (int IndexIndex = 0; IndexIndex < First.Combination.Count; ++IndexIndex)
+    {
+        struct solution Solution = Solutions[First.Combination.Indices[IndexIndex]];
+        RecordAppend(Record, IndexIndex ? " %.*s" : "%.*s", Solution.Length, Solution.Word);
+    }
+    RecordAppend(Record, "\n");
+    if (Job->Cache && !Record->Overflowed)
+    {
+        CacheInsert(Job->Cache, Key, KeySize, Record->Memory + ResultStart, (uint32_t)(Record->Used - ResultStart));
+    }
+}
+
+static char *SerializeBeeSolutions(struct memory_arena *Arena, struct spelling_bee_solution_builder *SolutionBuilder, uint32_t *Size)
+{
+    struct spelling_bee_solution *Solutions = (struct spelling_bee_solution *)SolutionBuilder->SolutionArena.Memory;
+    char *Result = (char *)ArenaPush(Arena, 0);
+    for (size_t SolutionIndex = 0; SolutionIndex < SolutionBuilder->SolutionCount; ++SolutionIndex)
+    {
+        struct spelling_bee_solution *Solution = Solutions + SolutionIndex;
+        char *Dest = PushArray(Arena, 2 + Solution->Length, char);
+        Dest[0] = Solution->Mask;
+        Dest[1] = Solution->Length;
+        Copy(Dest + 2, Solution->Word, Solution->Length);
+    }
+    *Size = (uint32_t)((char *)ArenaPush(Arena, 0) - Result);
+    return Result;
+}
+
+static void SolveBatchSpellingBee(struct memory_arena *Arena, struct batch_job *Job, struct batch_puzzle *BatchPuzzle, struct batch_record *Record)
+{
+    char SortedLetterBank[SPELLING_BEE_LETTER_BANK_SIZE + 1];
+    int CoreMask;
+    if (!ParseSpellingBeeLetterBank(BatchPuzzle->Contents, BatchPuzzle->Size, SortedLetterBank, &CoreMask))
+    {
+        RecordAppend(Record, "%s\terror\texpected %d distinct letters\n", BatchPuzzle->Name, SPELLING_BEE_LETTER_BANK_SIZE);
+        return;
+    }
+
+    char Key[2 + SPELLING_BEE_LETTER_BANK_SIZE] = "b-";
+    Copy(Key + 2, SortedLetterBank, SPELLING_BEE_LETTER_BANK_SIZE);
+    uint32_t WordsSize;
+    char *Words = Job->Cache ? CacheLookup(Job->Cache, Arena, Key, sizeof(Key), &WordsSize) : 0;
+    if (!Words)
+    {
+        int SolveMask = Job->Cache ? 0 : CoreMask;
+        struct spelling_bee_solution_builder *SolutionBuilder = (Job->BeeIndex ?
+                                                                 SolveSpellingBeeWithIndex(Arena, Job->BeeIndex, SortedLetterBank, SolveMask) :
+                                                                 SolveSpellingBeeWithDictionary(Arena, Job->Dictionary, SortedLetterBank, SolveMask));
+        Words = SerializeBeeSolutions(Arena, SolutionBuilder, &WordsSize);
+        if (Job->Cache)
+        {
+            CacheInsert(Job->Cache, Key, sizeof(Key), Words, WordsSize);
+        }
+    }
+
+    char *WordsEnd = Words + WordsSize;
+    size_t SolutionCount = 0;
+    int PangramCount = 0;
+    for (char *At = Words; At < WordsEnd; At += 2 + At[1])
+    {
+        if ((At[0] & CoreMask) == CoreMask)
+        {
+            SolutionCount++;
+            PangramCount += (At[0] & PANGRAM_BITS) == PANGRAM_BITS;
+        }
+    }
+    RecordAppend(Record, "%s\t%zu\t%d\t", BatchPuzzle->Name, SolutionCount, PangramCount);
+    char *Separator = "";
+    for (char *At = Words; At < WordsEnd; At += 2 + At[1])
+    {
+        if ((At[0] & CoreMask) == CoreMask)
+        {
+            char IsPangram = Job->ShowPangrams && (At[0] & PANGRAM_BITS) == PANGRAM_BITS;
+            RecordAppend(Record, "%s%.*s%s", Separator, At[1], At + 2, IsPangram ? "*" : "");
+            Separator = " ";
+        }
+    }
+    RecordAppend(Record, "\n");
+}
+
+static void *BatchWorkerProc(void *Parameter)
+{
+    struct batch_worker *Worker = (struct batch_worker *)Parameter;
+    struct batch_job *Job = Worker->Job;
+    struct batch_record Record = {0};
+    Record.Size = BATCH_RECORD_SIZE;
+    Record.Memory = ArenaPush(&Worker->Arena, Record.Size);
+
+    int PuzzleIndex;
+    while ((PuzzleIndex = __atomic_fetch_add(&Job->NextPuzzle, 1, __ATOMIC_RELAXED)) < Job->PuzzleCount)
+    {
+        struct batch_puzzle *Puzzle = Job->Puzzles + PuzzleIndex;
+        BeginRecord(&Record);
+        struct temporary_memory Temporary = BeginTemporaryMemory(&Worker->Arena);
+        if (Job->Game == nyt_game_Strands)
+        {
+            SolveBatchStrands(&Worker->Arena, &Worker->Builder, Job, Puzzle, &Record);
+        }
+        else
+        {
+            SolveBatchSpellingBee(&Worker->Arena, Job, Puzzle, &Record);
+        }
+        EndRecord(&Record, Puzzle->Name);
+        EndTemporaryMemory(Temporary);
+
+        pthread_mutex_lock(&Job->OutputLock);
+        fwrite(Record.Memory, 1, Record.Used, stdout);
+        pthread_mutex_unlock(&Job->OutputLock);
+    }
+    return 0;
+}
+
+static char *ReadStream(FILE *File, size_t *Size)
+{
+    size_t Capacity = 64*1024;
+    char *Result = malloc(Capacity);
+    *Size = 0;
+    size_t Read;
+    while ((Read = fread(Result + *Size, 1, Capacity - *Size, File)))
+    {
+        *Size += Read;
+        if (*Size == Capacity)
+        {
+            Capacity *= 2;
+            Result = realloc(Result, Capacity);
+        }
+    }
+    return Result;
+}
+
+static char *FormatString(char *Format, ...)
+{
+    va_list ArgList;
+    va_start(ArgList, Format);
+    int Length = vsnprintf(0, 0, Format, ArgList);
+    va_end(ArgList);
+    char *Result = malloc(Length + 1);
+    va_start(ArgList, Format);
+    vsnprintf(Result, Length + 1, Format, ArgList);
+    va_end(ArgList);
+    return Result;
+}
+
+static void AddBatchPuzzle(struct batch_job *Job, int *Capacity, char *Name, char *Contents, size_t Size)
+{
+    if (Job->PuzzleCount == *Capacity)
+    {
+        *Capacity = *Capacity ? 2 * *Capacity : 256;
+        Job->Puzzles = realloc(Job->Puzzles, *Capacity*sizeof(struct batch_puzzle));
+    }
+    struct batch_puzzle *Puzzle = Job->Puzzles + Job->PuzzleCount++;
+    Puzzle->Name = Name;
+    Puzzle->Contents = Contents;
+    Puzzle->Size = Size;
+}
+
+static void AddStrandsBlock(struct batch_job *Job, int *Capacity, char *SourceName, char *Start, char *End, int RowCount, int Width)
+{
+    int RowsPerPuzzle = RowCount;
+    if (Width == PUZZLE_SIZE)
+    {
+        RowsPerPuzzle = 1;
+    }
+    else if (Width == PUZZLE_WIDTH && RowCount % PUZZLE_HEIGHT == 0)
+    {
+        RowsPerPuzzle = PUZZLE_HEIGHT;
+    }
+    char *PuzzleStart = Start;
+    int Rows = 0;
+    for (char *At = Start; At < End; ++At)
+    {
+        if (*At == '\n' && ++Rows == RowsPerPuzzle)
+        {
+            AddBatchPuzzle(Job, Capacity, SourceName, PuzzleStart, At - PuzzleStart);
+            PuzzleStart = At + 1;
+            Rows = 0;
+        }
+    }
+    AddBatchPuzzle(Job, Capacity, SourceName, PuzzleStart, End - PuzzleStart);
+}
+
+static void SplitBatchSource(struct batch_job *Job, int *Capacity, char *SourceName, char *Contents, size_t Size)
+{
+    int FirstPuzzle = Job->PuzzleCount;
+    char *End = Contents + Size;
+    char *PuzzleStart = 0;
+    char *PuzzleEnd = 0;
+    int RowCount = 0;
+    int Width = 0;
+    for (char *LineStart = Contents; LineStart < End;)
+    {
+        char *LineEnd = LineStart;
+        while (LineEnd < End && *LineEnd != '\n')
+        {
+            LineEnd++;
+        }
+        char *TrimmedEnd = LineEnd;
+        while (LineStart < TrimmedEnd && (TrimmedEnd[-1] == '\r' || TrimmedEnd[-1] == ' ' || TrimmedEnd[-1] == '\t'))
+        {
+            TrimmedEnd--;
+        }
+        if (LineStart < TrimmedEnd && Job->Game == nyt_game_SpellingBee)
+        {
+            *TrimmedEnd = 0;
+            AddBatchPuzzle(Job, Capacity, LineStart, LineStart, TrimmedEnd - LineStart);
+        }
+        else if (LineStart < TrimmedEnd)
+        {
+            int RowWidth = (int)(TrimmedEnd - LineStart);
+            if (!PuzzleStart)
+            {
+                PuzzleStart = LineStart;
+                RowCount = 0;
+                Width = RowWidth;
+            }
+            Width = Width == RowWidth ? Width : -1;
+            RowCount++;
+            PuzzleEnd = TrimmedEnd;
+        }
+        else if (PuzzleStart)
+        {
+            AddStrandsBlock(Job, Capacity, SourceName, PuzzleStart, PuzzleEnd, RowCount, Width);
+            PuzzleStart = 0;
+        }
+        LineStart = LineEnd + 1;
+    }
+    if (PuzzleStart)
+    {
+        AddStrandsBlock(Job, Capacity, SourceName, PuzzleStart, PuzzleEnd, RowCount, Width);
+    }
+
+    if (Job->Game == nyt_game_Strands && 1 < Job->PuzzleCount - FirstPuzzle)
+    {
+        for (int PuzzleIndex = FirstPuzzle; PuzzleIndex < Job->PuzzleCount; ++PuzzleIndex)
+        {
+            Job->Puzzles[PuzzleIndex].Name = FormatString("%s:%d", SourceName, PuzzleIndex - FirstPuzzle + 1);
+        }
+    }
+}
+
+static int CompareNames(const void *A, const void *B)
+{
+    return strcmp(*(char **)A, *(char **)B);
+}
+
+static int LoadBatchPuzzles(struct batch_job *Job, char *Path)
+{
+    int Capacity = 0;
+    if (0 == strcmp(Path, "-"))
+    {
+        size_t Size;
+        char *Contents = ReadStream(stdin, &Size);
+        SplitBatchSource(Job, &Capacity, "-", Contents, Size);
+        return 1;
+    }
+
+    DIR *Directory = opendir(Path);
+    if (Directory)
+    {
+        int NameCount = 0;
+        int NameCapacity = 64;
+        char **Names = malloc(NameCapacity*sizeof(char *));
+        struct dirent *Entry;
+        while ((Entry = readdir(Directory)))
+        {
+            if (Entry->d_name[0] != '.')
+            {
+                if (NameCount == NameCapacity)
+                {
+                    NameCapacity *= 2;
+                    Names = realloc(Names, NameCapacity*sizeof(char *));
+                }
+                Names[NameCount++] = FormatString("%s/%s", Path, Entry->d_name);
+            }
+        }
+        closedir(Directory);
+        qsort(Names, NameCount, sizeof(char *), CompareNames);
+        for (int NameIndex = 0; NameIndex < NameCount; ++NameIndex)
+        {
+            FILE *File = fopen(Names[NameIndex], "rb");
+            if (File)
+            {
+                size_t Size;
+                char *Contents = ReadStream(File, &Size);
+                fclose(File);
+                SplitBatchSource(Job, &Capacity, Names[NameIndex], Contents, Size);
+            }
+        }
+        return 1;
+    }
+
+    FILE *File = fopen(Path, "rb");
+    if (!File)
+    {
+        printf("Failed to open %s\n", Path);
+        return 0;
+    }
+    size_t Size;
+    char *Contents = ReadStream(File, &Size);
+    fclose(File);
+    SplitBatchSource(Job, &Capacity, Path, Contents, Size);
+    return 1;
+}
+
+static int RunBatch(struct memory_arena *Arena, struct packed_assets_header *Assets, char *ExecutableName, int ArgCount, char **Args)
+{
+    struct batch_job Job = {0};
+    char *GameName = ArgCount > 2 ? Args[2] : "";
+    if (0 == strcmp(GameName, "strands"))
+    {
+        Job.Game = nyt_game_Strands;
+    }
+    else if (0 == strcmp(GameName, "bee"))
+    {
+        Job.Game = nyt_game_SpellingBee;
+    }
+    else
+    {
+        printf("usage: %s batch strands|bee [-d index|trie|dawg] [-j N] [-p] [-c MB] [-C cache dir] <directory|file|->\n", ExecutableName);
+        return 1;
+    }
+
+    char *Path = 0;
+    int ThreadCount = 1;
+    char UseIndex = Job.Game == nyt_game_SpellingBee;
+    size_t CacheMegabytes = RESULT_CACHE_DEFAULT_MEGABYTES;
+    char *CacheDirectory = 0;
+    enum dictionary_kind DictionaryKind = dictionary_kind_Dawg;
+    for (int ArgIndex = 3; ArgIndex < ArgCount; ++ArgIndex)
+    {
+        char *Arg = Args[ArgIndex];
+        if ('-' == *Arg && Arg[1])
+        {
+            if (0 == strcmp("-d", Arg) || 0 == strcmp("--dictionary", Arg))
+            {
+                char *Name = ++ArgIndex < ArgCount ? Args[ArgIndex] : 0;
+                if (Job.Game == nyt_game_SpellingBee ?
+                    !ParseBeeDictionaryKind(Name, &DictionaryKind, &UseIndex) :
+                    !ParseDictionaryKind(Name, &DictionaryKind))
+                {
+                    return 1;
+                }
+            }
+            else if (0 == strcmp("-j", Arg) || 0 == strcmp("--jobs", Arg))
+            {
+                if (!ParseThreadCount(++ArgIndex < ArgCount ? Args[ArgIndex] : 0, &ThreadCount))
+                {
+                    return 1;
+                }
+            }
+            else if (0 == strcmp("-p", Arg) || 0 == strcmp("--pangrams", Arg))
+            {
+                Job.ShowPangrams = 1;
+            }
+            else if (0 == strcmp("-c", Arg) || 0 == strcmp("--cache-size", Arg))
+            {
+                if (!ParseCacheSize(++ArgIndex < ArgCount ? Args[ArgIndex] : 0, &CacheMegabytes))
+                {
+                    return 1;
+                }
+            }
+            else if ((0 == strcmp("-C", Arg) || 0 == strcmp("--cache-dir", Arg)) && ArgIndex + 1 < ArgCount)
+            {
+                CacheDirectory = Args[++ArgIndex];
+            }
+            else
+            {
+                printf("Unrecognized option %s\nValid options are: -d, -j, -p, -c, -C\n", Arg);
+                return 1;
+            }
+        }
+        else
+        {
+            Path = Arg;
+        }
+    }
+    if (!Path)
+    {
+        printf("usage: %s batch %s [-d %s] [-j N] [-p] [-c MB] [-C cache dir] <directory|file|->\n", ExecutableName, GameName, Job.Game == nyt_game_SpellingBee ? "index|trie|dawg" : "trie|dawg");
+        return 1;
+    }
+    if (!LoadBatchPuzzles(&Job, Path))
+    {
+        return 1;
+    }
+
+    struct dictionary Dictionary = {0};
+    struct bee_index BeeIndex = {0};
+    if (UseIndex)
+    {
+        BeeIndex = LoadBeeIndex(Arena, Assets);
+        Job.BeeIndex = &BeeIndex;
+    }
+    else
+    {
+        Dictionary = LoadDictionary(Arena, Assets, DictionaryKind);
+    }
+    Job.Dictionary = &Dictionary;
+    Job.Cache = CreateResultCache(Arena, Assets, CacheMegabytes, CacheDirectory);
+    pthread_mutex_init(&Job.OutputLock, 0);
+    if (ThreadCount > Job.PuzzleCount)
+    {
+        ThreadCount = Job.PuzzleCount ? Job.PuzzleCount : 1;
+    }
+
+    struct batch_worker *Workers = (struct batch_worker *)ArenaPush(Arena, ThreadCount*sizeof(struct batch_worker));
+    for (int WorkerIndex = 0; WorkerIndex < ThreadCount; ++WorkerIndex)
+    {
+        struct batch_worker *Worker = Workers + WorkerIndex;
+        memset(Worker, 0, sizeof(*Worker));
+        Worker->Job = &Job;
+        Worker->Arena = ReserveArena(BATCH_WORKER_ARENA_SIZE, "batch worker");
+        Worker->Builder.StringArena = ReserveArena(BATCH_WORKER_ARENA_SIZE, "batch strings");
+        Worker->Builder.SolutionArena = ReserveArena(BATCH_WORKER_ARENA_SIZE, "batch solutions");
+    }
+    if (ThreadCount == 1)
+    {
+        BatchWorkerProc(Workers);
+    }
+    else
+    {
+        for (int WorkerIndex = 0; WorkerIndex < ThreadCount; ++WorkerIndex)
+        {
+            pthread_create(&Workers[WorkerIndex].Thread, 0, BatchWorkerProc, Workers + WorkerIndex);
+        }
+        for (int WorkerIndex = 0; WorkerIndex < ThreadCount; ++WorkerIndex)
+        {
+            pthread_join(Workers[WorkerIndex].Thread, 0);
+        }
+    }
+    if (Job.Cache)
+    {
+        PrintCacheStats(Job.Cache);
+    }
+    return 0;
+}
@@ -0,0 +1,570 @@
+#define BEE_INDEX_IMAGE_MAGIC ('N' | ('Y' << 8) | ('T' << 16) | ('B' << 24))
+#define BEE_INDEX_IMAGE_VERSION 1
+#define BEE_MIN_LENGTH 4
+
+struct bee_index_slot
+{
+    uint32_t Mask;
+    uint32_t FirstWord;
+    uint32_t WordCount;
+};
+
+struct bee_index
+{
+    uint32_t SlotMask;
+    uint32_t WordCount;
+    uint32_t StringSize;
+    struct bee_index_slot *Slots;
+    uint32_t *WordOffsets;
+    uint8_t *WordLengths;
+    char *Strings;
+};
+
+struct bee_index_image_header
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t SlotCount;
+    uint32_t WordCount;
+    uint32_t StringSize;
+};
+
+struct spelling_bee_cursor
+{
+    int MatchCount;
+    int MatchIndex;
+    uint32_t WordIndex;
+    size_t SolutionCount;
+    int MatchSubsets[PANGRAM_BITS + 1];
+    struct bee_index_slot *MatchSlots[PANGRAM_BITS + 1];
+};
+
+struct bee_word
+{
+    char *Start;
+    int Length;
+    uint32_t Mask;
+};
+
+static int NextBeeWord(struct lexicon_reader *Reader, struct bee_word *Word)
+{
+    while (NextLexiconWord(Reader))
+    {
+        uint32_t Mask = 0;
+        char IsWord = 1;
+        for (int CharIndex = 0; CharIndex < Reader->Length; ++CharIndex)
+        {
+            char Char = Reader->Word[CharIndex];
+            if ('a' <= Char && Char <= 'z')
+            {
+                Char = 'A' + (Char - 'a');
+            }
+            if ('A' <= Char && Char <= 'Z')
+            {
+                Mask |= 1u << (Char - 'A');
+            }
+            else
+            {
+                IsWord = 0;
+            }
+        }
+        if (IsWord && BEE_MIN_LENGTH <= Reader->Length && Reader->Length <= LEXICON_MAX_WORD && __builtin_popcount(Mask) <= SPELLING_BEE_LETTER_BANK_SIZE)
+        {
+            Word->Start = Reader->Word;
+            Word->Length = Reader->Length;
+            Word->Mask = Mask;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static inline uint32_t BeeIndexHash(uint32_t Mask)
+{
+    return Mask * 2654435761u;
+}
+
+static struct bee_index_slot *BeeIndexSlot(struct bee_index *Index, uint32_t Mask)
+{
+    uint32_t SlotIndex = BeeIndexHash(Mask) & Index->SlotMask;
+    struct bee_index_slot *Slot = Index->Slots + SlotIndex;
+    while (Slot->Mask && Slot->Mask != Mask)
+    {
+        SlotIndex = (SlotIndex + 1) & Index->SlotMask;
+        Slot = Index->Slots + SlotIndex;
+    }
+    return Slot;
+}
+
+static uint32_t BeeIndexSlotCount(uint32_t KeyCount)
+{
+    uint32_t Result = 1;
+    while (Result < 2*KeyCount)
+    {
+        Result <<= 1;
+    }
+    return Result;
+}
+
+static void ClearBeeIndexSlots(struct bee_index *Index)
+{
+    for (uint32_t SlotIndex = 0; SlotIndex <= Index->SlotMask; ++SlotIndex)
+    {
+        Index->Slots[SlotIndex].Mask = 0;
+        Index->Slots[SlotIndex].WordCount = 0;
+    }
+}
+
+struct bee_index BuildBeeIndex(struct memory_arena *Arena, char *Lexicon, size_t LexiconSize)
+{
+    PROFILE_BLOCK_BEGIN(BuildBeeIndex);
+    struct bee_index Index = {0};
+    struct bee_word Word;
+    struct lexicon_reader Reader = BeginLexicon(Lexicon, LexiconSize);
+    while (NextBeeWord(&Reader, &Word))
+    {
+        Index.WordCount++;
+        Index.StringSize += Word.Length;
+    }
+
+    Index.WordOffsets = PushArray(Arena, Index.WordCount, uint32_t);
+    Index.WordLengths = PushArray(Arena, Index.WordCount, uint8_t);
+    Index.Strings = PushArray(Arena, Index.StringSize, char);
+
+    uint32_t MaskCount = 0;
+    struct temporary_memory Temporary = BeginTemporaryMemory(Arena);
+    Index.SlotMask = BeeIndexSlotCount(Index.WordCount) - 1;
+    Index.Slots = PushArray(Arena, Index.SlotMask + 1, struct bee_index_slot);
+    ClearBeeIndexSlots(&Index);
+    Reader = BeginLexicon(Lexicon, LexiconSize);
+    while (NextBeeWord(&Reader, &Word))
+    {
+        struct bee_index_slot *Slot = BeeIndexSlot(&Index, Word.Mask);
+        MaskCount += !Slot->Mask;
+        Slot->Mask = Word.Mask;
+    }
+    EndTemporaryMemory(Temporary);
+
+    Index.SlotMask = BeeIndexSlotCount(MaskCount) - 1;
+    Index.Slots = PushArray(Arena, Index.SlotMask + 1, struct bee_index_slot);
+    ClearBeeIndexSlots(&Index);
+    uint32_t SlotCount = Index.SlotMask + 1;
+
+    Reader = BeginLexicon(Lexicon, LexiconSize);
+    while (NextBeeWord(&Reader, &Word))
+    {
+        struct bee_index_slot *Slot = BeeIndexSlot(&Index, Word.Mask);
+        Slot->Mask = Word.Mask;
+        Slot->WordCount++;
+    }
+
+    uint32_t FirstWord = 0;
+    for (uint32_t SlotIndex = 0; SlotIndex < SlotCount; ++SlotIndex)
+    {
+        struct bee_index_slot *Slot = Index.Slots + SlotIndex;
+        Slot->FirstWord = FirstWord;
+        FirstWord += Slot->WordCount;
+        Slot->WordCount = 0;
+    }
+
+    uint32_t StringOffset = 0;
+    Reader = BeginLexicon(Lexicon, LexiconSize);
+    while (NextBeeWord(&Reader, &Word))
+    {
+        struct bee_index_slot *Slot = BeeIndexSlot(&Index, Word.Mask);
+        uint32_t WordIndex = Slot->FirstWord + Slot->WordCount++;
+        Index.WordOffsets[WordIndex] = StringOffset;
+        Index.WordLengths[WordIndex] = (uint8_t)Word.Length;
+        for (int CharIndex = 0; CharIndex < Word.Length; ++CharIndex)
+        {
+            char Char = Word.Start[CharIndex];
+            Index.Strings[StringOffset++] = ('a' <= Char && Char <= 'z') ? 'A' + (Char - 'a') : Char;
+        }
+    }
+    PROFILE_BLOCK_END(BuildBeeIndex);
+    return Index;
+}
+
+static char BeeSolutionLess(struct spelling_bee_solution *A, struct spelling_bee_solution *B)
+{
+    int Length = A->Length < B->Length ? A->Length : B->Length;
+    for (int CharIndex = 0; CharIndex < Length; ++CharIndex)
+    {
+        if (A->Word[CharIndex] != B->Word[CharIndex])
+        {
+            return A->Word[CharIndex] < B->Word[CharIndex];
+        }
+    }
+    return A->Length < B->Length;
+}
+
+static void SortBeeSolutions(struct memory_arena *TempArena, struct spelling_bee_solution *Solutions, size_t Count)
+{
+    struct temporary_memory Temporary = BeginTemporaryMemory(TempArena);
+    struct spelling_bee_solution *Source = Solutions;
+    struct spelling_bee_solution *Dest = PushArray(TempArena, Count, struct spelling_bee_solution);
+    for (size_t Width = 1; Width < Count; Width *= 2)
+    {
+        for (size_t Start = 0; Start < Count; Start += 2*Width)
+        {
+            size_t Middle = Start + Width < Count ? Start + Width : Count;
+            size_t End = Middle + Width < Count ? Middle + Width : Count;
+            size_t Left = Start;
+            size_t Right = Middle;
+            for (size_t DestIndex = Start; DestIndex < End; ++DestIndex)
+            {
+                if (Left < Middle && (End <= Right || !BeeSolutionLess(Source + Right, Source + Left)))
+                {
+                    Dest[DestIndex] = Source[Left++];
+                }
+                else
+                {
+                    Dest[DestIndex] = Source[Right++];
+                }
+            }
+        }
+        struct spelling_bee_solution *Swap = Source;
+        Source = Dest;
+        Dest = Swap;
+    }
+    if (Source != Solutions)
+    {
+        Copy(Solutions, Source, Count*sizeof(struct spelling_bee_solution));
+    }
+    EndTemporaryMemory(Temporary);
+}
+
+static void BeginSpellingBeeCursor(struct spelling_bee_cursor *Cursor, struct bee_index *Index, char *SortedLetterBank, int CoreMask)
+{
+    uint32_t LetterBits[SPELLING_BEE_LETTER_BANK_SIZE];
+    for (int LetterIndex = 0; LetterIndex < SPELLING_BEE_LETTER_BANK_SIZE; ++LetterIndex)
+    {
+        LetterBits[LetterIndex] = 1u << (SortedLetterBank[LetterIndex] - 'A');
+    }
+
+    Cursor->MatchCount = 0;
+    Cursor->MatchIndex = 0;
+    Cursor->WordIndex = 0;
+    Cursor->SolutionCount = 0;
+    for (int Subset = 0; Subset <= PANGRAM_BITS; ++Subset)
+    {
+        if ((Subset & CoreMask) != CoreMask)
+        {
+            continue;
+        }
+        uint32_t Mask = 0;
+        for (int Bits = Subset; Bits; Bits &= Bits - 1)
+        {
+            Mask |= LetterBits[__builtin_ctz(Bits)];
+        }
+        struct bee_index_slot *Slot = BeeIndexSlot(Index, Mask);
+        if (Slot->Mask)
+        {
+            Cursor->MatchSubsets[Cursor->MatchCount] = Subset;
+            Cursor->MatchSlots[Cursor->MatchCount++] = Slot;
+            Cursor->SolutionCount += Slot->WordCount;
+        }
+    }
+}
+
+static size_t StepSpellingBeeCursor(struct spelling_bee_cursor *Cursor, struct bee_index *Index, struct spelling_bee_solution *Solutions, size_t MaxCount)
+{
+    size_t Result = 0;
+    while (Result < MaxCount && Cursor->MatchIndex < Cursor->MatchCount)
+    {
+        struct bee_index_slot *Slot = Cursor->MatchSlots[Cursor->MatchIndex];
+        if (Cursor->WordIndex < Slot->WordCount)
+        {
+            uint32_t WordIndex = Slot->FirstWord + Cursor->WordIndex++;
+            struct spelling_bee_solution *Solution = Solutions + Result++;
+            Solution->Mask = (char)Cursor->MatchSubsets[Cursor->MatchIndex];
+            Solution->Length = (char)Index->WordLengths[WordIndex];
+            Solution->Word = Index->Strings + Index->WordOffsets[WordIndex];
+        }
+        else
+        {
+            Cursor->MatchIndex++;
+            Cursor->WordIndex = 0;
+        }
+    }
+    return Result;
+}
+
+struct spelling_bee_solution_builder *SolveSpellingBeeWithIndex(struct memory_arena *Arena, struct bee_index *Index, char *SortedLetterBank, int CoreMask)
+{
+    PROFILE_BLOCK_BEGIN(SolveSpellingBee);
+    struct spelling_bee_cursor Cursor;
+    BeginSpellingBeeCursor(&Cursor, Index, SortedLetterBank, CoreMask);
+
+    struct spelling_bee_solution_builder *SolutionBuilder = PushStruct(Arena, spelling_bee_solution_builder);
+    SolutionBuilder->NodesVisited = CoreMask ? (PANGRAM_BITS + 1) / 2 : PANGRAM_BITS + 1;
+    SolutionBuilder->StringArena = SubArena(Arena, 0, "bee strings");
+    SolutionBuilder->SolutionArena = SubArena(Arena, Cursor.SolutionCount*sizeof(struct spelling_bee_solution), "bee solutions");
+    struct spelling_bee_solution *Solutions = PushArray(&SolutionBuilder->SolutionArena, Cursor.SolutionCount, struct spelling_bee_solution);
+    SolutionBuilder->SolutionCount = StepSpellingBeeCursor(&Cursor, Index, Solutions, Cursor.SolutionCount);
+
+    SortBeeSolutions(Arena, Solutions, SolutionBuilder->SolutionCount);
+    PROFILE_BLOCK_END(SolveSpellingBee);
+    return SolutionBuilder;
+}
+
+size_t BeeIndexImageSize(struct bee_index *Index)
+{
+    return (sizeof(struct bee_index_image_header) +
+            (Index->SlotMask + 1)*sizeof(struct bee_index_slot) +
+            Index->WordCount*(sizeof(uint32_t) + sizeof(uint8_t)) +
+            Index->StringSize);
+}
+
+void WriteBeeIndexImage(struct bee_index *Index, void *Destination)
+{
+    struct bee_index_image_header *Header = (struct bee_index_image_header *)Destination;
+    Header->Magic = BEE_INDEX_IMAGE_MAGIC;
+    Header->Version = BEE_INDEX_IMAGE_VERSION;
+    Header->SlotCount = Index->SlotMask + 1;
+    Header->WordCount = Index->WordCount;
+    Header->StringSize = Index->StringSize;
+    char *Dest = (char *)(Header + 1);
+    Dest += Copy(Dest, Index->Slots, Header->SlotCount*sizeof(struct bee_index_slot));
+    Dest += Copy(Dest, Index->WordOffsets, Index->WordCount*sizeof(uint32_t));
+    Dest += Copy(Dest, Index->WordLengths, Index->WordCount*sizeof(uint8_t));
+    Copy(Dest, Index->Strings, Index->StringSize);
+}
+
+struct bee_index LoadBeeIndexImage(void *Image, size_t Size)
+{
+    struct bee_index Result = {0};
+    struct bee_index_image_header *Header = (struct bee_index_image_header *)Image;
+    if (Header && sizeof(*Header) <= Size &&
+        Header->Magic == BEE_INDEX_IMAGE_MAGIC &&
+        Header->Version == BEE_INDEX_IMAGE_VERSION &&
+        Header->SlotCount && !(Header->SlotCount & (Header->SlotCount - 1)))
+    {
+        struct bee_index Index;
+        Index.SlotMask = Header->SlotCount - 1;
+        Index.WordCount = Header->WordCount;
+        Index.StringSize = Header->StringSize;
+        Index.Slots = (struct bee_index_slot *)(Header + 1);
+        Index.WordOffsets = (uint32_t *)(Index.Slots + Header->SlotCount);
+        Index.WordLengths = (uint8_t *)(Index.WordOffsets + Index.WordCount);
+        Index.Strings = (char *)(Index.WordLengths + Index.WordCount);
+        if (BeeIndexImageSize(&Index) <= Size)
+        {
+            Result = Index;
+        }
+    }
+    return Result;
+}
+
+#define BEE_PUZZLE_TABLE_MAGIC ('N' | ('Y' << 8) | ('T' << 16) | ('P' << 24))
+#define BEE_PUZZLE_TABLE_VERSION 1
+#define BEE_ALPHABET_SIZE 26
+#define BEE_PANGRAM_BONUS 7
+
+struct bee_puzzle_entry
+{
+    uint16_t PangramCount;
+    uint16_t WordCounts[SPELLING_BEE_LETTER_BANK_SIZE];
+    uint16_t Points[SPELLING_BEE_LETTER_BANK_SIZE];
+};
+
+struct bee_puzzle_table
+{
+    uint32_t BankCount;
+    uint32_t WordCount;
+    struct bee_puzzle_entry *Entries;
+    uint32_t Binomials[BEE_ALPHABET_SIZE + 1][SPELLING_BEE_LETTER_BANK_SIZE + 1];
+};
+
+struct bee_puzzle_table_header
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t BankCount;
+    uint32_t WordCount;
+};
+
+struct bee_puzzle_stats
+{
+    uint32_t WordCount;
+    uint32_t PangramCount;
+    uint32_t Points;
+};
+
+struct bee_mask_totals
+{
+    uint32_t WordCount;
+    uint32_t Points;
+};
+
+static inline uint32_t BeeWordPoints(int Length, uint32_t Mask)
+{
+    uint32_t Result = Length == BEE_MIN_LENGTH ? 1 : Length;
+    if (__builtin_popcount(Mask) == SPELLING_BEE_LETTER_BANK_SIZE)
+    {
+        Result += BEE_PANGRAM_BONUS;
+    }
+    return Result;
+}
+
+static inline uint16_t ClampBeeTotal(uint32_t Value)
+{
+    return Value < 0xFFFF ? (uint16_t)Value : 0xFFFF;
+}
+
+static void FillBeeBinomials(struct bee_puzzle_table *Table)
+{
+    for (int N = 0; N <= BEE_ALPHABET_SIZE; ++N)
+    {
+        Table->Binomials[N][0] = 1;
+        for (int K = 1; K <= SPELLING_BEE_LETTER_BANK_SIZE; ++K)
+        {
+            Table->Binomials[N][K] = N ? Table->Binomials[N - 1][K - 1] + Table->Binomials[N - 1][K] : 0;
+        }
+    }
+}
+
+static inline uint32_t BeeMaskRank(struct bee_puzzle_table *Table, uint32_t Mask)
+{
+    uint32_t Result = 0;
+    int BitIndex = 0;
+    for (; Mask; Mask &= Mask - 1)
+    {
+        Result += Table->Binomials[__builtin_ctz(Mask)][++BitIndex];
+    }
+    return Result;
+}
+
+static inline uint32_t NextBeeMask(uint32_t Mask)
+{
+    uint32_t Low = Mask & -Mask;
+    uint32_t Ripple = Mask + Low;
+    return Ripple | (((Mask ^ Ripple) >> 2) / Low);
+}
+
+struct bee_puzzle_table BuildBeePuzzleTable(struct memory_arena *Arena, char *Lexicon, size_t LexiconSize)
+{
+    PROFILE_BLOCK_BEGIN(BuildBeePuzzleTable);
+    struct bee_puzzle_table Table = {0};
+    FillBeeBinomials(&Table);
+
+    uint32_t LayerOffsets[SPELLING_BEE_LETTER_BANK_SIZE + 2];
+    LayerOffsets[0] = 0;
+    for (int Layer = 0; Layer <= SPELLING_BEE_LETTER_BANK_SIZE; ++Layer)
+    {
+        LayerOffsets[Layer + 1] = LayerOffsets[Layer] + Table.Binomials[BEE_ALPHABET_SIZE][Layer];
+    }
+    Table.BankCount = Table.Binomials[BEE_ALPHABET_SIZE][SPELLING_BEE_LETTER_BANK_SIZE];
+    Table.Entries = PushArray(Arena, Table.BankCount, struct bee_puzzle_entry);
+
+    struct temporary_memory Temporary = BeginTemporaryMemory(Arena);
+    uint32_t TotalCount = LayerOffsets[SPELLING_BEE_LETTER_BANK_SIZE + 1];
+    struct bee_mask_totals *Totals = PushArray(Arena, TotalCount, struct bee_mask_totals);
+    for (uint32_t TotalIndex = 0; TotalIndex < TotalCount; ++TotalIndex)
+    {
+        Totals[TotalIndex] = (struct bee_mask_totals){0};
+    }
+
+    struct bee_word Word;
+    struct lexicon_reader Reader = BeginLexicon(Lexicon, LexiconSize);
+    while (NextBeeWord(&Reader, &Word))
+    {
+        struct bee_mask_totals *Total = Totals + LayerOffsets[__builtin_popcount(Word.Mask)] + BeeMaskRank(&Table, Word.Mask);
+        Total->WordCount++;
+        Total->Points += BeeWordPoints(Word.Length, Word.Mask);
+        Table.WordCount++;
+    }
+
+    struct bee_mask_totals *Banks = Totals + LayerOffsets[SPELLING_BEE_LETTER_BANK_SIZE];
+    for (uint32_t BankIndex = 0; BankIndex < Table.BankCount; ++BankIndex)
+    {
+        Table.Entries[BankIndex].PangramCount = ClampBeeTotal(Banks[BankIndex].WordCount);
+    }
+
+    for (int Letter = 0; Letter < BEE_ALPHABET_SIZE; ++Letter)
+    {
+        uint32_t LetterBit = 1u << Letter;
+        for (int Layer = 1; Layer <= SPELLING_BEE_LETTER_BANK_SIZE; ++Layer)
+        {
+            struct bee_mask_totals *Supersets = Totals + LayerOffsets[Layer];
+            struct bee_mask_totals *Subsets = Totals + LayerOffsets[Layer - 1];
+            uint32_t Rank = 0;
+            for (uint32_t Mask = (1u << Layer) - 1; Mask < (1u << BEE_ALPHABET_SIZE); Mask = NextBeeMask(Mask), ++Rank)
+            {
+                if (Mask & LetterBit)
+                {
+                    struct bee_mask_totals *Subset = Subsets + BeeMaskRank(&Table, Mask & ~LetterBit);
+                    Supersets[Rank].WordCount += Subset->WordCount;
+                    Supersets[Rank].Points += Subset->Points;
+                }
+            }
+        }
+    }
+
+    struct bee_mask_totals *WithoutCore = Totals + LayerOffsets[SPELLING_BEE_LETTER_BANK_SIZE - 1];
+    uint32_t BankIndex = 0;
+    for (uint32_t Mask = (1u << SPELLING_BEE_LETTER_BANK_SIZE) - 1; Mask < (1u << BEE_ALPHABET_SIZE); Mask = NextBeeMask(Mask), ++BankIndex)
+    {
+        struct bee_puzzle_entry *Entry = Table.Entries + BankIndex;
+        int CoreIndex = 0;
+        for (uint32_t Letters = Mask; Letters; Letters &= Letters - 1, ++CoreIndex)
+        {
+            struct bee_mask_totals *Rest = WithoutCore + BeeMaskRank(&Table, Mask & ~(Letters & -Letters));
+            Entry->WordCounts[CoreIndex] = ClampBeeTotal(Banks[BankIndex].WordCount - Rest->WordCount);
+            Entry->Points[CoreIndex] = ClampBeeTotal(Banks[BankIndex].Points - Rest->Points);
+        }
+    }
+    EndTemporaryMemory(Temporary);
+    PROFILE_BLOCK_END(BuildBeePuzzleTable);
+    return Table;
+}
+
+int QueryBeePuzzle(struct bee_puzzle_table *Table, uint32_t LetterMask, int CoreLetter, struct bee_puzzle_stats *Stats)
+{
+    int Result = 0;
+    if (Table->Entries &&
+        __builtin_popcount(LetterMask) == SPELLING_BEE_LETTER_BANK_SIZE && LetterMask < (1u << BEE_ALPHABET_SIZE) &&
+        0 <= CoreLetter && CoreLetter < BEE_ALPHABET_SIZE && (LetterMask & (1u << CoreLetter)))
+    {
+        struct bee_puzzle_entry *Entry = Table->Entries + BeeMaskRank(Table, LetterMask);
+        int CoreIndex = __builtin_popcount(LetterMask & ((1u << CoreLetter) - 1));
+        Stats->WordCount = Entry->WordCounts[CoreIndex];
+        Stats->PangramCount = Entry->PangramCount;
+        Stats->Points = Entry->Points[CoreIndex];
+        Result = 1;
+    }
+    return Result;
+}
+
+size_t BeePuzzleTableImageSize(struct bee_puzzle_table *Table)
+{
+    return sizeof(struct bee_puzzle_table_header) + Table->BankCount*sizeof(struct bee_puzzle_entry);
+}
+
+void WriteBeePuzzleTableImage(struct bee_puzzle_table *Table, void *Destination)
+{
+    struct bee_puzzle_table_header *Header = (struct bee_puzzle_table_header *)Destination;
+    Header->Magic = BEE_PUZZLE_TABLE_MAGIC;
+    Header->Version = BEE_PUZZLE_TABLE_VERSION;
+    Header->BankCount = Table->BankCount;
+    Header->WordCount = Table->WordCount;
+    Copy(Header + 1, Table->Entries, Table->BankCount*sizeof(struct bee_puzzle_entry));
+}
+
+struct bee_puzzle_table LoadBeePuzzleTableImage(void *Image, size_t Size)
+{
+    struct bee_puzzle_table Result = {0};
+    struct bee_puzzle_table_header *Header = (struct bee_puzzle_table_header *)Image;
+    FillBeeBinomials(&Result);
+    if (Header && sizeof(*Header) <= Size &&
+        Header->Magic == BEE_PUZZLE_TABLE_MAGIC &&
+        Header->Version == BEE_PUZZLE_TABLE_VERSION &&
+        Header->BankCount == Result.Binomials[BEE_ALPHABET_SIZE][SPELLING_BEE_LETTER_BANK_SIZE] &&
+        sizeof(*Header) + Header->BankCount*sizeof(struct bee_puzzle_entry) <= Size)
+    {
+        Result.BankCount = Header->BankCount;
+        Result.WordCount = Header->WordCount;
+        Result.Entries = (struct bee_puzzle_entry *)(Header + 1);
+    }
+    return Result;
+}
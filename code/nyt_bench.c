@@ -0,0 +1,543 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "nyt.c"
+#include "nyt_posix.c"
+
+#define BENCH_MAX_ARENAS 4
+
+enum bench_format
+{
+    bench_format_Table,
+    bench_format_Json,
+};
+
+struct bench_stage
+{
+    char *Stage;
+    char *Dictionary;
+    char *Corpus;
+    int ArenaCount;
+    struct memory_arena *Arenas[BENCH_MAX_ARENAS];
+    size_t ArenaBase[BENCH_MAX_ARENAS];
+    size_t ArenaPeak[BENCH_MAX_ARENAS];
+    uint64_t Start;
+    size_t Ops;
+    size_t Results;
+    size_t NodesVisited;
+    size_t NodesPruned;
+};
+
+static char *SimdLevelNames[] =
+{
+    "unknown",
+    "scalar",
+    "sse2",
+    "avx2",
+    "simd128",
+};
+
+static enum bench_format Format;
+static struct bench_stage *ActiveStage;
+
+static char *ReadEntireFile(char *Filename, size_t *Size)
+{
+    char *Result = 0;
+    FILE *File = fopen(Filename, "rb");
+    if (File)
+    {
+        fseek(File, 0, SEEK_END);
+        *Size = ftell(File);
+        fseek(File, 0, SEEK_SET);
+        Result = malloc(*Size + 1);
+        *Size = fread(Result, 1, *Size, File);
+        Result[*Size] = 0;
+        fclose(File);
+    }
+    return Result;
+}
+
+static uint64_t NextRandom(uint64_t *State)
+{
+    uint64_t X = *State;
+    X ^= X >> 12;
+    X ^= X << 25;
+    X ^= X >> 27;
+    *State = X;
+    return X * 0x2545F4914F6CDD1Dull;
+}
+
+static void GenerateRandomBoard(uint64_t *State, uint64_t *LetterWeights, struct strands_puzzle *Puzzle, int Width, int Height)
+{
+    for (int CellIndex = 0; CellIndex < Width*Height; ++CellIndex)
+    {
+        uint64_t Pick = NextRandom(State) % LetterWeights[25];
+        int Letter = 0;
+        while (LetterWeights[Letter] <= Pick)
+        {
+            Letter++;
+        }
+        Puzzle->Letters[CellIndex] = 'A' + Letter;
+    }
+    BuildStrandsPuzzle(Puzzle, Width, Height);
+}
+
+static void BeginStage(struct bench_stage *Stage, char *Name, char *Dictionary, char *Corpus, int ArenaCount, struct memory_arena **Arenas)
+{
+    Stage->Stage = Name;
+    Stage->Dictionary = Dictionary;
+    Stage->Corpus = Corpus;
+    Stage->ArenaCount = ArenaCount;
+    for (int ArenaIndex = 0; ArenaIndex < ArenaCount; ++ArenaIndex)
+    {
+        struct memory_arena *Arena = Arenas[ArenaIndex];
+        Stage->Arenas[ArenaIndex] = Arena;
+        Stage->ArenaBase[ArenaIndex] = Arena->Allocated;
+        Stage->ArenaPeak[ArenaIndex] = 0;
+        Arena->HighWater = Arena->Allocated;
+        Arena->PushCount = 0;
+    }
+    Stage->Ops = 0;
+    Stage->Results = 0;
+    Stage->NodesVisited = 0;
+    Stage->NodesPruned = 0;
+    Stage->Start = GetNanoseconds();
+    ActiveStage = Stage;
+}
+
+static size_t StageArenaPeak(struct bench_stage *Stage, int ArenaIndex)
+{
+    size_t Peak = Stage->Arenas[ArenaIndex]->HighWater - Stage->ArenaBase[ArenaIndex];
+    return Stage->ArenaPeak[ArenaIndex] < Peak ? Peak : Stage->ArenaPeak[ArenaIndex];
+}
+
+static void ResetBenchArena(struct memory_arena *Arena)
+{
+    for (int ArenaIndex = 0; ActiveStage && ArenaIndex < ActiveStage->ArenaCount; ++ArenaIndex)
+    {
+        if (ActiveStage->Arenas[ArenaIndex] == Arena)
+        {
+            ActiveStage->ArenaPeak[ArenaIndex] = StageArenaPeak(ActiveStage, ArenaIndex);
+            ActiveStage->ArenaBase[ArenaIndex] = 0;
+        }
+    }
+    ResetArena(Arena);
+    Arena->HighWater = 0;
+}
+
+static void EndStage(struct bench_stage *Stage)
+{
+    uint64_t Elapsed = GetNanoseconds() - Stage->Start;
+    ActiveStage = 0;
+    size_t Allocations = 0;
+    size_t HighWater = 0;
+    for (int ArenaIndex = 0; ArenaIndex < Stage->ArenaCount; ++ArenaIndex)
+    {
+        struct memory_arena *Arena = Stage->Arenas[ArenaIndex];
+        Allocations += Arena->PushCount;
+        HighWater += StageArenaPeak(Stage, ArenaIndex);
+    }
+    size_t Ops = Stage->Ops ? Stage->Ops : 1;
+    if (Format == bench_format_Json)
+    {
+        printf("{\"stage\":\"%s\",\"dict\":\"%s\",\"corpus\":\"%s\",\"ops\":%zu,\"ns_per_op\":%.1f,"
+               "\"results\":%zu,\"nodes_per_op\":%.1f,\"pruned_per_op\":%.1f,\"allocs_per_op\":%.1f,\"high_water\":%zu}\n",
+               Stage->Stage, Stage->Dictionary, Stage->Corpus, Stage->Ops, (double)Elapsed / Ops,
+               Stage->Results, (double)Stage->NodesVisited / Ops, (double)Stage->NodesPruned / Ops, (double)Allocations / Ops, HighWater);
+    }
+    else
+    {
+        printf("%-12s %-6s %-28s %8zu %14.1f %10zu %14.1f %12.1f %10.1f %12zu\n",
+               Stage->Stage, Stage->Dictionary, Stage->Corpus, Stage->Ops, (double)Elapsed / Ops,
+               Stage->Results, (double)Stage->NodesVisited / Ops, (double)Stage->NodesPruned / Ops, (double)Allocations / Ops, HighWater);
+    }
+}
+
+static void SolveStrandsBoard(struct dictionary *Dictionary, struct strands_puzzle *Puzzle, struct solution_builder *SolutionBuilder)
+{
+    SolutionBuilder->SolutionCount = 0;
+    ResetBenchArena(&SolutionBuilder->StringArena);
+    ResetBenchArena(&SolutionBuilder->SolutionArena);
+    for (int CellIndex = 0; CellIndex < Puzzle->CellCount; ++CellIndex)
+    {
+        SolveStrandsCell(Puzzle, CellIndex, Dictionary, SolutionBuilder);
+    }
+}
+
+static void CountCombination(void *Context, struct solution *Solutions, int *Indices, int Count)
+{
+}
+
+static void PrintUsage(char *ExecutableName)
+{
+    printf("usage: %s [--json] [--scalar] [--no-prune] [-n random boards] [-g random board WxH] [-s seed] [-i iterations] [-b bank stride] <lexicon> [strands puzzle files...]\n", ExecutableName);
+}
+
+int main(int ArgCount, char *Args[])
+{
+    char *LexiconPath = 0;
+    char **BoardPaths = (char **)malloc(ArgCount*sizeof(char *));
+    int BoardPathCount = 0;
+    int RandomBoardCount = 100;
+    uint64_t Seed = 0x9E3779B97F4A7C15ull;
+    int Iterations = 5;
+    int BankStride = 64;
+    int Prune = 1;
+    int RandomWidth = PUZZLE_WIDTH;
+    int RandomHeight = PUZZLE_HEIGHT;
+    for (int ArgIndex = 1; ArgIndex < ArgCount; ++ArgIndex)
+    {
+        char *Arg = Args[ArgIndex];
+        char *Value = ArgIndex + 1 < ArgCount ? Args[ArgIndex + 1] : 0;
+        if (0 == strcmp("--json", Arg))
+        {
+            Format = bench_format_Json;
+        }
+        else if (0 == strcmp("--scalar", Arg))
+        {
+            SimdLevel = simd_level_Scalar;
+        }
+        else if (0 == strcmp("--no-prune", Arg))
+        {
+            Prune = 0;
+        }
+        else if (Value && 0 == strcmp("-n", Arg))
+        {
+            RandomBoardCount = atoi(Value) < 0 ? 0 : atoi(Value);
+            ArgIndex++;
+        }
+        else if (Value && 0 == strcmp("-g", Arg) &&
+                 2 == sscanf(Value, "%dx%d", &RandomWidth, &RandomHeight) &&
+                 0 < RandomWidth && 0 < RandomHeight && RandomWidth*RandomHeight <= PUZZLE_MAX_CELLS)
+        {
+            ArgIndex++;
+        }
+        else if (Value && 0 == strcmp("-s", Arg))
+        {
+            Seed = strtoull(Value, 0, 0) | 1;
+            ArgIndex++;
+        }
+        else if (Value && 0 == strcmp("-i", Arg))
+        {
+            Iterations = atoi(Value) < 1 ? 1 : atoi(Value);
+            ArgIndex++;
+        }
+        else if (Value && 0 == strcmp("-b", Arg))
+        {
+            BankStride = atoi(Value) < 1 ? 1 : atoi(Value);
+            ArgIndex++;
+        }
+        else if ('-' == *Arg)
+        {
+            PrintUsage(Args[0]);
+            return 1;
+        }
+        else if (!LexiconPath)
+        {
+            LexiconPath = Arg;
+        }
+        else
+        {
+            BoardPaths[BoardPathCount++] = Arg;
+        }
+    }
+    if (!LexiconPath)
+    {
+        PrintUsage(Args[0]);
+        return 1;
+    }
+
+    size_t LexiconSize;
+    char *Lexicon = ReadEntireFile(LexiconPath, &LexiconSize);
+    if (!Lexicon)
+    {
+        printf("Failed to open lexicon %s\n", LexiconPath);
+        return 1;
+    }
+
+    fprintf(stderr, "simd: %s\n", SimdLevelNames[GetSimdLevel()]);
+    if (Format == bench_format_Table)
+    {
+        printf("%-12s %-6s %-28s %8s %14s %10s %14s %12s %10s %12s\n",
+               "stage", "dict", "corpus", "ops", "ns/op", "results", "nodes/op", "pruned/op", "allocs/op", "high water");
+    }
+
+    struct memory_arena Arena = ReserveArena(4ull*1024*1024*1024, "bench");
+    struct memory_arena *MainArenas[] = { &Arena, };
+    struct bench_stage Stage;
+
+    BeginStage(&Stage, "build_trie", "trie", "lexicon", 1, MainArenas);
+    for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        struct temporary_memory Temporary = BeginTemporaryMemory(&Arena);
+        struct trie_builder Builder = BuildTrieFromLexicon(&Arena, Lexicon, LexiconSize);
+        Stage.Results = Builder.WordCount;
+        Stage.NodesVisited += Builder.NodeCount;
+        Stage.Ops++;
+        EndTemporaryMemory(Temporary);
+    }
+    EndStage(&Stage);
+
+    BeginStage(&Stage, "build_shards", "trie", "lexicon", 1, MainArenas);
+    for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        struct temporary_memory Temporary = BeginTemporaryMemory(&Arena);
+        struct trie_builder Builder = BuildTrieParallel(&Arena, Lexicon, LexiconSize, 0);
+        Stage.Results = Builder.WordCount;
+        Stage.NodesVisited += Builder.NodeCount;
+        Stage.Ops++;
+        EndTemporaryMemory(Temporary);
+    }
+    EndStage(&Stage);
+    struct trie_builder Builder = BuildTrieFromLexicon(&Arena, Lexicon, LexiconSize);
+
+    BeginStage(&Stage, "build_dawg", "dawg", "lexicon", 1, MainArenas);
+    for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        struct temporary_memory Temporary = BeginTemporaryMemory(&Arena);
+        struct dawg Dawg = BuildDawgFromTrie(&Arena, Builder.Root, Builder.NodeCount);
+        Stage.Results = Dawg.NodeCount;
+        Stage.NodesVisited += Builder.NodeCount;
+        Stage.Ops++;
+        EndTemporaryMemory(Temporary);
+    }
+    EndStage(&Stage);
+    struct dawg Dawg = BuildDawgFromTrie(&Arena, Builder.Root, Builder.NodeCount);
+
+    BeginStage(&Stage, "build_index", "index", "lexicon", 1, MainArenas);
+    for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        struct temporary_memory Temporary = BeginTemporaryMemory(&Arena);
+        struct bee_index BeeIndex = BuildBeeIndex(&Arena, Lexicon, LexiconSize);
+        Stage.Results = BeeIndex.WordCount;
+        Stage.Ops++;
+        EndTemporaryMemory(Temporary);
+    }
+    EndStage(&Stage);
+    struct bee_index BeeIndex = BuildBeeIndex(&Arena, Lexicon, LexiconSize);
+
+    BeginStage(&Stage, "build_table", "table", "lexicon", 1, MainArenas);
+    for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        struct temporary_memory Temporary = BeginTemporaryMemory(&Arena);
+        struct bee_puzzle_table BeeTable = BuildBeePuzzleTable(&Arena, Lexicon, LexiconSize);
+        Stage.Results = BeeTable.BankCount;
+        Stage.Ops++;
+        EndTemporaryMemory(Temporary);
+    }
+    EndStage(&Stage);
+    struct bee_puzzle_table BeeTable = BuildBeePuzzleTable(&Arena, Lexicon, LexiconSize);
+
+    struct dictionary Dictionaries[2];
+    char *TrieImage = PushArray(&Arena, TrieImageSize(&Builder), char);
+    WriteTrieImage(&Builder, TrieImage);
+    Dictionaries[dictionary_kind_Trie] = TrieImageDictionary(LoadTrieImage(TrieImage, TrieImageSize(&Builder)));
+    Dictionaries[dictionary_kind_Dawg] = DawgDictionary(Dawg);
+    if (!Prune)
+    {
+        Dictionaries[dictionary_kind_Trie].Summaries = Dictionaries[dictionary_kind_Dawg].Summaries = 0;
+    }
+    char *DictionaryNames[] = { "trie", "dawg", };
+
+    int BoardCount = 0;
+    char **BoardNames = (char **)malloc((BoardPathCount + 1)*sizeof(char *));
+    struct strands_puzzle *Boards = (struct strands_puzzle *)malloc((BoardPathCount + 1)*sizeof(struct strands_puzzle));
+    for (int PathIndex = 0; PathIndex < BoardPathCount; ++PathIndex)
+    {
+        size_t FileSize;
+        char *FileContents = ReadEntireFile(BoardPaths[PathIndex], &FileSize);
+        if (!FileContents || !ParseStrandsPuzzle(FileContents, FileSize, Boards + BoardCount))
+        {
+            fprintf(stderr, "%s skipped (expected rows of equal length)\n", BoardPaths[PathIndex]);
+        }
+        else
+        {
+            BoardNames[BoardCount++] = BoardPaths[PathIndex];
+        }
+        free(FileContents);
+    }
+
+    uint64_t LetterWeights[26] = {0};
+    for (char *At = Lexicon; *At; ++At)
+    {
+        if ('A' <= *At && *At <= 'Z')
+        {
+            LetterWeights[*At - 'A']++;
+        }
+    }
+    for (int Letter = 1; Letter < 26; ++Letter)
+    {
+        LetterWeights[Letter] += LetterWeights[Letter - 1];
+    }
+    struct strands_puzzle *RandomBoards = (struct strands_puzzle *)malloc((RandomBoardCount + 1)*sizeof(struct strands_puzzle));
+    uint64_t RandomState = Seed;
+    for (int BoardIndex = 0; BoardIndex < RandomBoardCount; ++BoardIndex)
+    {
+        GenerateRandomBoard(&RandomState, LetterWeights, RandomBoards + BoardIndex, RandomWidth, RandomHeight);
+    }
+    char RandomCorpusName[64];
+    snprintf(RandomCorpusName, sizeof(RandomCorpusName), "random:%d:%dx%d:%llx", RandomBoardCount, RandomWidth, RandomHeight, (unsigned long long)Seed);
+
+    struct solution_builder SolutionBuilder = {0};
+    SolutionBuilder.StringArena = ReserveArena(256*1024*1024, "strings");
+    SolutionBuilder.SolutionArena = ReserveArena(256*1024*1024, "solutions");
+    struct memory_arena *StrandsArenas[] = { &Arena, &SolutionBuilder.StringArena, &SolutionBuilder.SolutionArena, };
+
+    for (int Kind = 0; Kind < 2; ++Kind)
+    {
+        for (int BoardIndex = 0; BoardIndex < BoardCount; ++BoardIndex)
+        {
+            BeginStage(&Stage, "solve", DictionaryNames[Kind], BoardNames[BoardIndex], 3, StrandsArenas);
+            for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+            {
+                SolutionBuilder.NodesVisited = SolutionBuilder.NodesPruned = 0;
+                SolveStrandsBoard(Dictionaries + Kind, Boards + BoardIndex, &SolutionBuilder);
+                Stage.NodesVisited += SolutionBuilder.NodesVisited;
+                Stage.NodesPruned += SolutionBuilder.NodesPruned;
+                Stage.Results = SolutionBuilder.SolutionCount;
+                Stage.Ops++;
+            }
+            EndStage(&Stage);
+        }
+
+        for (int BoardIndex = 0; BoardIndex < BoardCount; ++BoardIndex)
+        {
+            struct strands_puzzle *Puzzle = Boards + BoardIndex;
+            SetStrandsUnknownCells(Puzzle, unknown_cells_Wildcard, DEFAULT_MAX_WILDCARDS);
+            BeginStage(&Stage, "solve_wildcard", DictionaryNames[Kind], BoardNames[BoardIndex], 3, StrandsArenas);
+            for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+            {
+                SolutionBuilder.NodesVisited = SolutionBuilder.NodesPruned = 0;
+                SolveStrandsBoard(Dictionaries + Kind, Puzzle, &SolutionBuilder);
+                Stage.NodesVisited += SolutionBuilder.NodesVisited;
+                Stage.NodesPruned += SolutionBuilder.NodesPruned;
+                Stage.Results = SolutionBuilder.SolutionCount;
+                Stage.Ops++;
+            }
+            EndStage(&Stage);
+            SetStrandsUnknownCells(Puzzle, unknown_cells_Literal, 0);
+        }
+
+        BeginStage(&Stage, "solve", DictionaryNames[Kind], RandomCorpusName, 3, StrandsArenas);
+        for (int BoardIndex = 0; BoardIndex < RandomBoardCount; ++BoardIndex)
+        {
+            SolutionBuilder.NodesVisited = SolutionBuilder.NodesPruned = 0;
+            SolveStrandsBoard(Dictionaries + Kind, RandomBoards + BoardIndex, &SolutionBuilder);
+            Stage.NodesVisited += SolutionBuilder.NodesVisited;
+            Stage.NodesPruned += SolutionBuilder.NodesPruned;
+            Stage.Results += SolutionBuilder.SolutionCount;
+            Stage.Ops++;
+        }
+        EndStage(&Stage);
+    }
+
+    for (int BoardIndex = 0; BoardIndex < BoardCount; ++BoardIndex)
+    {
+        SolveStrandsBoard(Dictionaries + dictionary_kind_Dawg, Boards + BoardIndex, &SolutionBuilder);
+        DeduplicateSolutions(Boards + BoardIndex, &SolutionBuilder, &Arena);
+
+        BeginStage(&Stage, "exact_cover", "-", BoardNames[BoardIndex], 3, StrandsArenas);
+        for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            SolutionBuilder.CombineNodesVisited = 0;
+            Stage.Results = ExactCover(&Arena, Boards + BoardIndex, &SolutionBuilder, 0, CountCombination, 0);
+            Stage.NodesVisited += SolutionBuilder.CombineNodesVisited;
+            Stage.Ops++;
+        }
+        EndStage(&Stage);
+
+        BeginStage(&Stage, "combine_full", "-", BoardNames[BoardIndex], 3, StrandsArenas);
+        for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            SolutionBuilder.CombineNodesVisited = 0;
+            Stage.Results = Combine(Boards + BoardIndex, &SolutionBuilder, combine_mode_Full, CountCombination, 0);
+            Stage.NodesVisited += SolutionBuilder.CombineNodesVisited;
+            Stage.Ops++;
+        }
+        EndStage(&Stage);
+
+        BeginStage(&Stage, "combine_memo", "-", BoardNames[BoardIndex], 3, StrandsArenas);
+        for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            struct combine_summary Summary;
+            SolutionBuilder.CombineMemoLookups = 0;
+            SolutionBuilder.CombineMemoHits = 0;
+            Stage.Results = CombineMemoized(&Arena, Boards + BoardIndex, &SolutionBuilder, &Summary);
+            Stage.NodesVisited += SolutionBuilder.CombineMemoLookups;
+            Stage.NodesPruned += SolutionBuilder.CombineMemoHits;
+            Stage.Ops++;
+        }
+        EndStage(&Stage);
+    }
+
+    BeginStage(&Stage, "exact_cover", "-", RandomCorpusName, 3, StrandsArenas);
+    for (int BoardIndex = 0; BoardIndex < RandomBoardCount; ++BoardIndex)
+    {
+        SolveStrandsBoard(Dictionaries + dictionary_kind_Dawg, RandomBoards + BoardIndex, &SolutionBuilder);
+        DeduplicateSolutions(RandomBoards + BoardIndex, &SolutionBuilder, &Arena);
+        SolutionBuilder.CombineNodesVisited = 0;
+        Stage.Results += ExactCover(&Arena, RandomBoards + BoardIndex, &SolutionBuilder, 0, CountCombination, 0);
+        Stage.NodesVisited += SolutionBuilder.CombineNodesVisited;
+        Stage.Ops++;
+    }
+    EndStage(&Stage);
+
+    int BankCount = 0;
+    uint32_t *BankMasks = (uint32_t *)malloc((BeeIndex.SlotMask + 1)*sizeof(uint32_t));
+    for (uint32_t SlotIndex = 0; SlotIndex <= BeeIndex.SlotMask; ++SlotIndex)
+    {
+        uint32_t Mask = BeeIndex.Slots[SlotIndex].Mask;
+        if (__builtin_popcount(Mask) == SPELLING_BEE_LETTER_BANK_SIZE)
+        {
+            BankMasks[BankCount++] = Mask;
+        }
+    }
+
+    for (int Kind = 0; Kind < 3; ++Kind)
+    {
+        int Stride = Kind < 2 ? BankStride : 1;
+        char CorpusName[64];
+        snprintf(CorpusName, sizeof(CorpusName), "banks:%d/%d", (BankCount + Stride - 1) / Stride, BankCount);
+        BeginStage(&Stage, "bee", Kind < 2 ? DictionaryNames[Kind] : "index", CorpusName, 1, MainArenas);
+        for (int BankIndex = 0; BankIndex < BankCount; BankIndex += Stride)
+        {
+            char SortedLetterBank[SPELLING_BEE_LETTER_BANK_SIZE + 1];
+            char *Dest = SortedLetterBank;
+            for (uint32_t Letters = BankMasks[BankIndex]; Letters; Letters &= Letters - 1)
+            {
+                *Dest++ = 'A' + __builtin_ctz(Letters);
+            }
+            *Dest = 0;
+            for (int CoreIndex = 0; CoreIndex < SPELLING_BEE_LETTER_BANK_SIZE; ++CoreIndex)
+            {
+                struct temporary_memory Temporary = BeginTemporaryMemory(&Arena);
+                struct spelling_bee_solution_builder *BeeBuilder = (Kind < 2 ?
+                                                                    SolveSpellingBeeWithDictionary(&Arena, Dictionaries + Kind, SortedLetterBank, 1 << CoreIndex) :
+                                                                    SolveSpellingBeeWithIndex(&Arena, &BeeIndex, SortedLetterBank, 1 << CoreIndex));
+                Stage.Results += BeeBuilder->SolutionCount;
+                Stage.NodesVisited += BeeBuilder->NodesVisited;
+                Arena.PushCount += BeeBuilder->StringArena.PushCount + BeeBuilder->SolutionArena.PushCount;
+                Stage.Ops++;
+                EndTemporaryMemory(Temporary);
+            }
+        }
+        EndStage(&Stage);
+    }
+
+    char CorpusName[64];
+    snprintf(CorpusName, sizeof(CorpusName), "banks:%d/%d", BankCount, BankCount);
+    BeginStage(&Stage, "bee", "table", CorpusName, 1, MainArenas);
+    for (int BankIndex = 0; BankIndex < BankCount; ++BankIndex)
+    {
+        for (uint32_t Letters = BankMasks[BankIndex]; Letters; Letters &= Letters - 1)
+        {
+            struct bee_puzzle_stats Stats;
+            QueryBeePuzzle(&BeeTable, BankMasks[BankIndex], __builtin_ctz(Letters), &Stats);
+            Stage.Results += Stats.WordCount;
+            Stage.Ops++;
+        }
+    }
+    EndStage(&Stage);
+
+    return 0;
+}
@@ -0,0 +1,291 @@
+#define RESULT_CACHE_MAGIC ('N' | ('Y' << 8) | ('T' << 16) | ('C' << 24))
+#define RESULT_CACHE_VERSION 2
+#define RESULT_CACHE_BUCKET_COUNT 4096
+#define RESULT_CACHE_MAX_PATH 4096
+#define RESULT_CACHE_DEFAULT_MEGABYTES 64
+
+struct result_cache_entry
+{
+    struct result_cache_entry *HashNext;
+    struct result_cache_entry *Older;
+    struct result_cache_entry *Newer;
+    uint32_t Hash;
+    uint32_t KeySize;
+    uint32_t ValueSize;
+    char *Key;
+    char *Value;
+};
+
+struct result_cache_file_header
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint64_t Fingerprint;
+    uint32_t KeySize;
+    uint32_t ValueSize;
+};
+
+struct result_cache
+{
+    pthread_mutex_t Lock;
+    struct result_cache_entry *Buckets[RESULT_CACHE_BUCKET_COUNT];
+    struct result_cache_entry Recent;
+    size_t Bytes;
+    size_t MaxBytes;
+    size_t Hits;
+    size_t DiskHits;
+    size_t Misses;
+    char *Directory;
+    uint64_t Fingerprint;
+};
+
+static uint32_t HashCacheKey(char *Key, uint32_t KeySize)
+{
+    uint32_t Hash = 2166136261u;
+    for (uint32_t CharIndex = 0; CharIndex < KeySize; ++CharIndex)
+    {
+        Hash = (Hash ^ (uint8_t)Key[CharIndex]) * 16777619u;
+    }
+    return Hash;
+}
+
+static uint64_t FingerprintBytes(char *Memory, size_t Size)
+{
+    uint64_t Hash = 14695981039346656037ull ^ Size;
+    for (size_t CharIndex = 0; CharIndex < Size; ++CharIndex)
+    {
+        Hash = (Hash ^ (uint8_t)Memory[CharIndex]) * 1099511628211ull;
+    }
+    return Hash;
+}
+
+static void InitResultCache(struct result_cache *Cache, size_t MaxBytes, char *Directory, uint64_t Fingerprint)
+{
+    memset(Cache, 0, sizeof(*Cache));
+    pthread_mutex_init(&Cache->Lock, 0);
+    Cache->Recent.Older = Cache->Recent.Newer = &Cache->Recent;
+    Cache->MaxBytes = MaxBytes;
+    Cache->Directory = Directory;
+    Cache->Fingerprint = Fingerprint;
+}
+
+static void UnlinkCacheEntry(struct result_cache_entry *Entry)
+{
+    Entry->Older->Newer = Entry->Newer;
+    Entry->Newer->Older = Entry->Older;
+}
+
+static void LinkCacheEntry(struct result_cache *Cache, struct result_cache_entry *Entry)
+{
+    Entry->Older = &Cache->Recent;
+    Entry->Newer = Cache->Recent.Newer;
+    Entry->Newer->Older = Entry;
+    Cache->Recent.Newer = Entry;
+}
+
+static struct result_cache_entry **FindCacheEntry(struct result_cache *Cache, uint32_t Hash, char *Key, uint32_t KeySize)
+{
+    struct result_cache_entry **Slot = Cache->Buckets + (Hash & (RESULT_CACHE_BUCKET_COUNT - 1));
+    while (*Slot && !((*Slot)->Hash == Hash && (*Slot)->KeySize == KeySize && 0 == memcmp((*Slot)->Key, Key, KeySize)))
+    {
+        Slot = &(*Slot)->HashNext;
+    }
+    return Slot;
+}
+
+static void EvictCacheEntries(struct result_cache *Cache)
+{
+    while (Cache->MaxBytes < Cache->Bytes && Cache->Recent.Older != &Cache->Recent)
+    {
+        struct result_cache_entry *Entry = Cache->Recent.Older;
+        UnlinkCacheEntry(Entry);
+        *FindCacheEntry(Cache, Entry->Hash, Entry->Key, Entry->KeySize) = Entry->HashNext;
+        Cache->Bytes -= sizeof(*Entry) + Entry->KeySize + Entry->ValueSize;
+        free(Entry);
+    }
+}
+
+static void StoreCacheEntry(struct result_cache *Cache, uint32_t Hash, char *Key, uint32_t KeySize, char *Value, uint32_t ValueSize)
+{
+    size_t EntrySize = sizeof(struct result_cache_entry) + KeySize + ValueSize;
+    if (Cache->MaxBytes < EntrySize)
+    {
+        return;
+    }
+    struct result_cache_entry **Slot = FindCacheEntry(Cache, Hash, Key, KeySize);
+    if (*Slot)
+    {
+        return;
+    }
+    struct result_cache_entry *Entry = (struct result_cache_entry *)malloc(EntrySize);
+    Entry->HashNext = 0;
+    Entry->Hash = Hash;
+    Entry->KeySize = KeySize;
+    Entry->ValueSize = ValueSize;
+    Entry->Key = (char *)(Entry + 1);
+    Entry->Value = Entry->Key + KeySize;
+    Copy(Entry->Key, Key, KeySize);
+    Copy(Entry->Value, Value, ValueSize);
+    *Slot = Entry;
+    LinkCacheEntry(Cache, Entry);
+    Cache->Bytes += EntrySize;
+    EvictCacheEntries(Cache);
+}
+
+static void GetCacheFilePath(struct result_cache *Cache, char *Key, uint32_t KeySize, char *Path, size_t PathSize)
+{
+    snprintf(Path, PathSize, "%s/%016llx", Cache->Directory, (unsigned long long)FingerprintBytes(Key, KeySize));
+}
+
+static char *ReadCacheFile(struct result_cache *Cache, struct memory_arena *Arena, char *Key, uint32_t KeySize, uint32_t *ValueSize)
+{
+    char *Result = 0;
+    char Path[RESULT_CACHE_MAX_PATH];
+    GetCacheFilePath(Cache, Key, KeySize, Path, sizeof(Path));
+    FILE *File = fopen(Path, "rb");
+    if (File)
+    {
+        struct result_cache_file_header Header;
+        fseek(File, 0, SEEK_END);
+        long FileSize = ftell(File);
+        fseek(File, 0, SEEK_SET);
+        if ((long)sizeof(Header) <= FileSize &&
+            1 == fread(&Header, sizeof(Header), 1, File) &&
+            Header.Magic == RESULT_CACHE_MAGIC &&
+            Header.Version == RESULT_CACHE_VERSION &&
+            Header.Fingerprint == Cache->Fingerprint &&
+            Header.KeySize == KeySize &&
+            FileSize == (long)(sizeof(Header) + Header.KeySize + Header.ValueSize))
+        {
+            struct temporary_memory Temporary = BeginTemporaryMemory(Arena);
+            char *StoredKey = PushArray(Arena, KeySize, char);
+            char KeyMatches = (StoredKey && KeySize == fread(StoredKey, 1, KeySize, File) &&
+                               0 == memcmp(StoredKey, Key, KeySize));
+            EndTemporaryMemory(Temporary);
+            if (KeyMatches)
+            {
+                *ValueSize = Header.ValueSize;
+                Result = PushArray(Arena, *ValueSize, char);
+                if (Result && *ValueSize != fread(Result, 1, *ValueSize, File))
+                {
+                    Result = 0;
+                }
+            }
+        }
+        fclose(File);
+    }
+    return Result;
+}
+
+static void WriteCacheFile(struct result_cache *Cache, char *Key, uint32_t KeySize, char *Value, uint32_t ValueSize)
+{
+    char Path[RESULT_CACHE_MAX_PATH];
+    char TempPath[RESULT_CACHE_MAX_PATH + 32];
+    GetCacheFilePath(Cache, Key, KeySize, Path, sizeof(Path));
+    snprintf(TempPath, sizeof(TempPath), "%s.%lx.tmp", Path, (unsigned long)pthread_self());
+    FILE *File = fopen(TempPath, "wb");
+    if (File)
+    {
+        struct result_cache_file_header Header;
+        Header.Magic = RESULT_CACHE_MAGIC;
+        Header.Version = RESULT_CACHE_VERSION;
+        Header.Fingerprint = Cache->Fingerprint;
+        Header.KeySize = KeySize;
+        Header.ValueSize = ValueSize;
+        int Written = (1 == fwrite(&Header, sizeof(Header), 1, File) &&
+                       KeySize == fwrite(Key, 1, KeySize, File) &&
+                       ValueSize == fwrite(Value, 1, ValueSize, File));
+        if (0 == fclose(File) && Written)
+        {
+            rename(TempPath, Path);
+        }
+        else
+        {
+            unlink(TempPath);
+        }
+    }
+}
+
+static char *CacheLookup(struct result_cache *Cache, struct memory_arena *Arena, char *Key, uint32_t KeySize, uint32_t *ValueSize)
+{
+    char *Result = 0;
+    uint32_t Hash = HashCacheKey(Key, KeySize);
+    pthread_mutex_lock(&Cache->Lock);
+    struct result_cache_entry *Entry = *FindCacheEntry(Cache, Hash, Key, KeySize);
+    if (Entry)
+    {
+        UnlinkCacheEntry(Entry);
+        LinkCacheEntry(Cache, Entry);
+        *ValueSize = Entry->ValueSize;
+        Result = PushArray(Arena, Entry->ValueSize, char);
+        Copy(Result, Entry->Value, Entry->ValueSize);
+        Cache->Hits++;
+    }
+    pthread_mutex_unlock(&Cache->Lock);
+
+    if (!Result && Cache->Directory)
+    {
+        Result = ReadCacheFile(Cache, Arena, Key, KeySize, ValueSize);
+        if (Result)
+        {
+            pthread_mutex_lock(&Cache->Lock);
+            StoreCacheEntry(Cache, Hash, Key, KeySize, Result, *ValueSize);
+            Cache->DiskHits++;
+            pthread_mutex_unlock(&Cache->Lock);
+        }
+    }
+    if (!Result)
+    {
+        __atomic_fetch_add(&Cache->Misses, 1, __ATOMIC_RELAXED);
+    }
+    return Result;
+}
+
+static void CacheInsert(struct result_cache *Cache, char *Key, uint32_t KeySize, char *Value, uint32_t ValueSize)
+{
+    pthread_mutex_lock(&Cache->Lock);
+    StoreCacheEntry(Cache, HashCacheKey(Key, KeySize), Key, KeySize, Value, ValueSize);
+    pthread_mutex_unlock(&Cache->Lock);
+    if (Cache->Directory)
+    {
+        WriteCacheFile(Cache, Key, KeySize, Value, ValueSize);
+    }
+}
+
+static void PrintCacheStats(struct result_cache *Cache)
+{
+    fprintf(stderr, "cache: %zu hits, %zu disk hits, %zu misses, %zu / %zu bytes\n",
+            Cache->Hits, Cache->DiskHits, Cache->Misses, Cache->Bytes, Cache->MaxBytes);
+}
+
+static struct result_cache *CreateResultCache(struct memory_arena *Arena, struct packed_assets_header *Assets, size_t Megabytes, char *Directory)
+{
+    struct result_cache *Result = 0;
+    if (Megabytes || Directory)
+    {
+        uint64_t Fingerprint = 0;
+        if (Directory)
+        {
+            Fingerprint = FingerprintBytes(GetPackedAsset(Assets, packed_asset_Lexicon), Assets->Assets[packed_asset_Lexicon].Size);
+        }
+        Result = PushStruct(Arena, result_cache);
+        InitResultCache(Result, Megabytes*1024*1024, Directory, Fingerprint);
+    }
+    return Result;
+}
+
+static int ParseCacheSize(char *Value, size_t *Megabytes)
+{
+    char *End = 0;
+    long Parsed = Value ? strtol(Value, &End, 10) : -1;
+    int Result = Value && *Value && !*End && 0 <= Parsed;
+    if (Result)
+    {
+        *Megabytes = (size_t)Parsed;
+    }
+    else
+    {
+        printf("Expected a cache size in megabytes, got %s\n", Value ? Value : "(none)");
+    }
+    return Result;
+}
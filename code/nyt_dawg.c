@@ -0,0 +1,202 @@
+#define DAWG_TERMINAL 0x80000000u
+#define DAWG_LETTER_BITS 0x03FFFFFFu
+
+#define DAWG_IMAGE_MAGIC ('N' | ('Y' << 8) | ('T' << 16) | ('D' << 24))
+#define DAWG_IMAGE_VERSION 2
+
+struct dawg_node
+{
+    uint32_t ChildMask;
+    uint32_t FirstEdge;
+};
+
+struct dawg
+{
+    uint32_t NodeCount;
+    uint32_t EdgeCount;
+    struct dawg_node *Nodes;
+    uint32_t *Summaries;
+    uint32_t *Edges;
+};
+
+struct dawg_image_header
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t NodeCount;
+    uint32_t EdgeCount;
+};
+
+struct dawg_builder
+{
+    struct dawg Dawg;
+    uint32_t TableMask;
+    uint32_t *Table;
+};
+
+static inline uint32_t DawgLetterBit(char Char)
+{
+    return 1u << (Char - 'A');
+}
+
+static inline uint32_t DawgFindChild(struct dawg *Dawg, uint32_t NodeIndex, char Char)
+{
+    uint32_t Result = 0;
+    struct dawg_node Node = Dawg->Nodes[NodeIndex];
+    uint32_t Letter = (uint32_t)(Char - 'A');
+    uint32_t Bit = 1u << (Letter & 31);
+    if (Letter < 26 && (Node.ChildMask & Bit))
+    {
+        Result = Dawg->Edges[Node.FirstEdge + __builtin_popcount(Node.ChildMask & (Bit - 1))];
+    }
+    return Result;
+}
+
+static inline char DawgTerminal(struct dawg *Dawg, uint32_t NodeIndex)
+{
+    return (Dawg->Nodes[NodeIndex].ChildMask & DAWG_TERMINAL) != 0;
+}
+
+static uint32_t DawgHash(uint32_t ChildMask, uint32_t *Children, int ChildCount)
+{
+    uint32_t Hash = 2166136261u ^ ChildMask;
+    for (int ChildIndex = 0; ChildIndex < ChildCount; ++ChildIndex)
+    {
+        Hash = (Hash ^ Children[ChildIndex]) * 16777619u;
+        Hash ^= Hash >> 15;
+    }
+    return Hash;
+}
+
+static char DawgNodeEquals(struct dawg *Dawg, uint32_t NodeIndex, uint32_t ChildMask, uint32_t *Children, int ChildCount)
+{
+    struct dawg_node Node = Dawg->Nodes[NodeIndex];
+    char Result = Node.ChildMask == ChildMask;
+    for (int ChildIndex = 0; Result && ChildIndex < ChildCount; ++ChildIndex)
+    {
+        Result = Dawg->Edges[Node.FirstEdge + ChildIndex] == Children[ChildIndex];
+    }
+    return Result;
+}
+
+static uint32_t DawgInsert(struct dawg_builder *Builder, struct trie_node *TrieNode, char IsRoot)
+{
+    uint32_t Children[26];
+    uint32_t ChildMask = TrieTerminal(TrieNode) ? DAWG_TERMINAL : 0;
+    for (struct trie_node *Child = TrieFirstChild(TrieNode); Child; Child = TrieSibling(Child))
+    {
+        char Char = Child->Value & 0x7F;
+        ChildMask |= DawgLetterBit(Char);
+        Children[Char - 'A'] = DawgInsert(Builder, Child, 0);
+    }
+
+    struct dawg *Dawg = &Builder->Dawg;
+    uint32_t Summary = (ChildMask & DAWG_TERMINAL) ? 0 : NODE_SUMMARY_EMPTY;
+    int ChildCount = 0;
+    for (uint32_t Letters = ChildMask & DAWG_LETTER_BITS; Letters; Letters &= Letters - 1)
+    {
+        int Letter = __builtin_ctz(Letters);
+        Summary = MergeNodeSummary(Summary, 'A' + Letter, Dawg->Summaries[Children[Letter]]);
+        Children[ChildCount++] = Children[Letter];
+    }
+    uint32_t *Slot = 0;
+    if (!IsRoot)
+    {
+        uint32_t SlotIndex = DawgHash(ChildMask, Children, ChildCount) & Builder->TableMask;
+        Slot = Builder->Table + SlotIndex;
+        while (*Slot)
+        {
+            if (DawgNodeEquals(Dawg, *Slot, ChildMask, Children, ChildCount))
+            {
+                return *Slot;
+            }
+            SlotIndex = (SlotIndex + 1) & Builder->TableMask;
+            Slot = Builder->Table + SlotIndex;
+        }
+    }
+
+    uint32_t Result = IsRoot ? 0 : Dawg->NodeCount++;
+    struct dawg_node *Node = Dawg->Nodes + Result;
+    Node->ChildMask = ChildMask;
+    Node->FirstEdge = Dawg->EdgeCount;
+    Dawg->Summaries[Result] = Summary;
+    Copy(Dawg->Edges + Dawg->EdgeCount, Children, ChildCount*sizeof(uint32_t));
+    Dawg->EdgeCount += ChildCount;
+    if (Slot)
+    {
+        *Slot = Result;
+    }
+    return Result;
+}
+
+struct dawg BuildDawgFromTrie(struct memory_arena *Arena, struct trie_node *Root, size_t TrieNodeCount)
+{
+    PROFILE_BLOCK_BEGIN(BuildDawg);
+    struct dawg_builder Builder = {0};
+    struct dawg *Dawg = &Builder.Dawg;
+    Dawg->NodeCount = 1;
+    Dawg->Nodes = PushArray(Arena, TrieNodeCount, struct dawg_node);
+    Dawg->Summaries = PushArray(Arena, TrieNodeCount, uint32_t);
+    Dawg->Edges = PushArray(Arena, TrieNodeCount, uint32_t);
+
+    struct temporary_memory Temporary = BeginTemporaryMemory(Arena);
+    uint32_t TableSize = 1;
+    while (TableSize < 2*TrieNodeCount)
+    {
+        TableSize <<= 1;
+    }
+    Builder.TableMask = TableSize - 1;
+    Builder.Table = PushArray(Arena, TableSize, uint32_t);
+    for (uint32_t SlotIndex = 0; SlotIndex < TableSize; ++SlotIndex)
+    {
+        Builder.Table[SlotIndex] = 0;
+    }
+
+    DawgInsert(&Builder, Root, 1);
+    EndTemporaryMemory(Temporary);
+    PROFILE_BLOCK_END(BuildDawg);
+    return *Dawg;
+}
+
+size_t DawgImageSize(struct dawg *Dawg)
+{
+    return (sizeof(struct dawg_image_header) +
+            Dawg->NodeCount*(sizeof(struct dawg_node) + sizeof(uint32_t)) +
+            Dawg->EdgeCount*sizeof(uint32_t));
+}
+
+void WriteDawgImage(struct dawg *Dawg, void *Destination)
+{
+    struct dawg_image_header *Header = (struct dawg_image_header *)Destination;
+    Header->Magic = DAWG_IMAGE_MAGIC;
+    Header->Version = DAWG_IMAGE_VERSION;
+    Header->NodeCount = Dawg->NodeCount;
+    Header->EdgeCount = Dawg->EdgeCount;
+    char *Dest = (char *)(Header + 1);
+    Dest += Copy(Dest, Dawg->Nodes, Dawg->NodeCount*sizeof(struct dawg_node));
+    Dest += Copy(Dest, Dawg->Summaries, Dawg->NodeCount*sizeof(uint32_t));
+    Copy(Dest, Dawg->Edges, Dawg->EdgeCount*sizeof(uint32_t));
+}
+
+struct dawg LoadDawgImage(void *Image, size_t Size)
+{
+    struct dawg Result = {0};
+    struct dawg_image_header *Header = (struct dawg_image_header *)Image;
+    if (Header && sizeof(*Header) <= Size &&
+        Header->Magic == DAWG_IMAGE_MAGIC &&
+        Header->Version == DAWG_IMAGE_VERSION &&
+        0 < Header->NodeCount)
+    {
+        struct dawg Dawg;
+        Dawg.NodeCount = Header->NodeCount;
+        Dawg.EdgeCount = Header->EdgeCount;
+        Dawg.Nodes = (struct dawg_node *)(Header + 1);
+        Dawg.Summaries = (uint32_t *)(Dawg.Nodes + Dawg.NodeCount);
+        Dawg.Edges = Dawg.Summaries + Dawg.NodeCount;
+        if (DawgImageSize(&Dawg) <= Size)
+        {
+            Result = Dawg;
+        }
+    }
+    return Result;
+}
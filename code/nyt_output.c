@@ -0,0 +1,312 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define OUTPUT_BUFFER_SIZE (1024*1024)
+#define OUTPUT_MAGIC ('N' | ('Y' << 8) | ('T' << 16) | ('O' << 24))
+#define OUTPUT_VERSION 1
+
+enum output_format
+{
+    output_format_Text,
+    output_format_Ndjson,
+    output_format_Binary,
+};
+
+enum output_record
+{
+    output_record_Count = 1,
+    output_record_Solution,
+    output_record_Combination,
+    output_record_Words,
+};
+
+struct output_buffer
+{
+    FILE *File;
+    enum output_format Format;
+    char SummaryOnly;
+    int MaskWords;
+    size_t Used;
+    char Memory[OUTPUT_BUFFER_SIZE];
+};
+
+struct output_header
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint16_t Width;
+    uint16_t Height;
+    uint16_t CellCount;
+    uint16_t MaskWords;
+};
+
+static struct output_buffer Output;
+
+static void FlushOutput(struct output_buffer *Output)
+{
+    if (Output->Used)
+    {
+        fwrite(Output->Memory, 1, Output->Used, Output->File);
+        Output->Used = 0;
+    }
+    fflush(Output->File);
+}
+
+static inline char *OutputReserve(struct output_buffer *Output, size_t Size)
+{
+    if (OUTPUT_BUFFER_SIZE - Output->Used < Size)
+    {
+        FlushOutput(Output);
+    }
+    char *Result = Output->Memory + Output->Used;
+    Output->Used += Size;
+    return Result;
+}
+
+static inline void OutputBytes(struct output_buffer *Output, void *Data, size_t Size)
+{
+    Copy(OutputReserve(Output, Size), Data, Size);
+}
+
+static inline void OutputChar(struct output_buffer *Output, char Char)
+{
+    *OutputReserve(Output, 1) = Char;
+}
+
+static inline void OutputString(struct output_buffer *Output, char *String)
+{
+    OutputBytes(Output, String, strlen(String));
+}
+
+static void OutputUnsigned(struct output_buffer *Output, uint64_t Value)
+{
+    char Digits[20];
+    int DigitCount = 0;
+    do
+    {
+        Digits[DigitCount++] = (char)('0' + Value % 10);
+        Value /= 10;
+    } while (Value);
+    char *Dest = OutputReserve(Output, DigitCount);
+    while (DigitCount)
+    {
+        *Dest++ = Digits[--DigitCount];
+    }
+}
+
+static void OutputHex64(struct output_buffer *Output, uint64_t Value)
+{
+    char *Dest = OutputReserve(Output, 16);
+    for (int Shift = 60; 0 <= Shift; Shift -= 4)
+    {
+        *Dest++ = "0123456789abcdef"[(Value >> Shift) & 0xF];
+    }
+}
+
+static void OutputText(struct output_buffer *Output, char *Format, ...)
+{
+    char Line[256];
+    va_list ArgList;
+    va_start(ArgList, Format);
+    int Written = vsnprintf(Line, sizeof(Line), Format, ArgList);
+    va_end(ArgList);
+    if (0 < Written)
+    {
+        OutputBytes(Output, Line, (size_t)Written < sizeof(Line) ? (size_t)Written : sizeof(Line) - 1);
+    }
+}
+
+static void OutputName(struct output_buffer *Output, char *Name)
+{
+    uint8_t Length = (uint8_t)strlen(Name);
+    OutputChar(Output, (char)Length);
+    OutputBytes(Output, Name, Length);
+}
+
+static void BeginOutput(struct output_buffer *Output, FILE *File, enum output_format Format, char SummaryOnly, struct strands_puzzle *Puzzle)
+{
+    Output->File = File;
+    Output->Format = Format;
+    Output->SummaryOnly = SummaryOnly;
+    Output->MaskWords = (Puzzle->CellCount + 63) / 64;
+    Output->Used = 0;
+    if (Format == output_format_Ndjson)
+    {
+        OutputString(Output, "{\"type\":\"board\",\"width\":");
+        OutputUnsigned(Output, Puzzle->Width);
+        OutputString(Output, ",\"height\":");
+        OutputUnsigned(Output, Puzzle->Height);
+        OutputString(Output, ",\"cells\":");
+        OutputUnsigned(Output, Puzzle->CellCount);
+        OutputString(Output, ",\"mask_words\":");
+        OutputUnsigned(Output, Output->MaskWords);
+        OutputString(Output, "}\n");
+    }
+    else if (Format == output_format_Binary)
+    {
+        struct output_header Header;
+        Header.Magic = OUTPUT_MAGIC;
+        Header.Version = OUTPUT_VERSION;
+        Header.Width = (uint16_t)Puzzle->Width;
+        Header.Height = (uint16_t)Puzzle->Height;
+        Header.CellCount = (uint16_t)Puzzle->CellCount;
+        Header.MaskWords = (uint16_t)Output->MaskWords;
+        OutputBytes(Output, &Header, sizeof(Header));
+    }
+}
+
+static void OutputCount(struct output_buffer *Output, char *Name, char *Label, uint64_t Value)
+{
+    switch (Output->Format)
+    {
+        case output_format_Text:
+        {
+            OutputString(Output, Label);
+            OutputString(Output, ": ");
+            OutputUnsigned(Output, Value);
+            OutputChar(Output, '\n');
+        } break;
+
+        case output_format_Ndjson:
+        {
+            OutputString(Output, "{\"type\":\"count\",\"name\":\"");
+            OutputString(Output, Name);
+            OutputString(Output, "\",\"value\":");
+            OutputUnsigned(Output, Value);
+            OutputString(Output, "}\n");
+        } break;
+
+        case output_format_Binary:
+        {
+            OutputChar(Output, output_record_Count);
+            OutputName(Output, Name);
+            OutputBytes(Output, &Value, sizeof(Value));
+        } break;
+    }
+}
+
+static void OutputSolution(struct output_buffer *Output, struct strands_puzzle *Puzzle, struct solution *Solution)
+{
+    if (Output->SummaryOnly)
+    {
+        return;
+    }
+    int MaskWords = Output->MaskWords;
+    uint64_t *Mask = Puzzle->Board == strands_board_Wide ? Solution->Cells->Words : &Solution->PuzzleMask;
+    switch (Output->Format)
+    {
+        case output_format_Text:
+        {
+            OutputBytes(Output, Solution->Word, Solution->Length);
+            OutputString(Output, " (");
+            if (Puzzle->Board == strands_board_Wide)
+            {
+                for (int WordIndex = MaskWords - 1; 0 <= WordIndex; --WordIndex)
+                {
+                    OutputHex64(Output, Mask[WordIndex]);
+                }
+            }
+            else
+            {
+                OutputUnsigned(Output, *Mask);
+            }
+            OutputString(Output, ")\n");
+        } break;
+
+        case output_format_Ndjson:
+        {
+            OutputString(Output, "{\"type\":\"solution\",\"word\":\"");
+            OutputBytes(Output, Solution->Word, Solution->Length);
+            OutputString(Output, "\",\"cells\":\"");
+            for (int WordIndex = MaskWords - 1; 0 <= WordIndex; --WordIndex)
+            {
+                OutputHex64(Output, Mask[WordIndex]);
+            }
+            OutputString(Output, "\"}\n");
+        } break;
+
+        case output_format_Binary:
+        {
+            OutputChar(Output, output_record_Solution);
+            OutputChar(Output, Solution->Length);
+            OutputBytes(Output, Solution->Word, Solution->Length);
+            OutputBytes(Output, Mask, MaskWords*sizeof(uint64_t));
+        } break;
+    }
+}
+
+static void OutputWordList(struct output_buffer *Output, enum output_record Record, char *Name, struct solution *Solutions, int *Indices, int Count)
+{
+    switch (Output->Format)
+    {
+        case output_format_Text:
+        {
+            for (int IndexIndex = 0; IndexIndex < Count; ++IndexIndex)
+            {
+                struct solution *Solution = Solutions + Indices[IndexIndex];
+                int Length = Solution->Length;
+                char *Dest = OutputReserve(Output, Length + 1);
+                Copy(Dest, Solution->Word, Length);
+                Dest[Length] = '\n';
+            }
+            if (Record == output_record_Combination)
+            {
+                OutputString(Output, "====\n");
+            }
+        } break;
+
+        case output_format_Ndjson:
+        {
+            OutputString(Output, "{\"type\":\"");
+            OutputString(Output, Name);
+            OutputString(Output, "\",\"indices\":[");
+            for (int IndexIndex = 0; IndexIndex < Count; ++IndexIndex)
+            {
+                if (IndexIndex)
+                {
+                    OutputChar(Output, ',');
+                }
+                OutputUnsigned(Output, (uint64_t)Indices[IndexIndex]);
+            }
+            OutputString(Output, "],\"words\":[");
+            for (int IndexIndex = 0; IndexIndex < Count; ++IndexIndex)
+            {
+                struct solution *Solution = Solutions + Indices[IndexIndex];
+                OutputString(Output, IndexIndex ? ",\"" : "\"");
+                OutputBytes(Output, Solution->Word, Solution->Length);
+                OutputChar(Output, '"');
+            }
+            OutputString(Output, "]}\n");
+        } break;
+
+        case output_format_Binary:
+        {
+            uint16_t IndexCount = (uint16_t)Count;
+            OutputChar(Output, (char)Record);
+            if (Record == output_record_Words)
+            {
+                OutputName(Output, Name);
+            }
+            OutputBytes(Output, &IndexCount, sizeof(IndexCount));
+            for (int IndexIndex = 0; IndexIndex < Count; ++IndexIndex)
+            {
+                uint32_t Index = (uint32_t)Indices[IndexIndex];
+                OutputBytes(Output, &Index, sizeof(Index));
+            }
+        } break;
+    }
+}
+
+static void OutputCombination(struct output_buffer *Output, struct solution *Solutions, int *Indices, int Count)
+{
+    if (!Output->SummaryOnly)
+    {
+        OutputWordList(Output, output_record_Combination, "combination", Solutions, Indices, Count);
+    }
+}
+
+static void OutputWords(struct output_buffer *Output, char *Name, struct solution *Solutions, int *Indices, int Count)
+{
+    OutputWordList(Output, output_record_Words, Name, Solutions, Indices, Count);
+}
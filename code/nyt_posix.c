@@ -0,0 +1,164 @@
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define TRIE_MAX_SHARDS 26
+
+static int CommitPages(void *Memory, size_t Size)
+{
+    return 0 == mprotect(Memory, Size, PROT_READ | PROT_WRITE);
+}
+
+static void ReportArenaOverflow(struct memory_arena *Arena, size_t Requested)
+{
+    fprintf(stderr, "Pushed too much on arena %s! (%zu + %zu / %zu)\n",
+            Arena->Name ? Arena->Name : "(unnamed)", Arena->Allocated, Requested,
+            Arena->Reserved ? Arena->Reserved : Arena->Size);
+    if (Arena->Flags & arena_flag_FailHard)
+    {
+        exit(1);
+    }
+}
+
+static struct memory_arena ReserveArena(size_t Reserved, char *Name)
+{
+    struct memory_arena Result = {0};
+    void *Memory = mmap(0, Reserved, PROT_NONE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (Memory != MAP_FAILED)
+    {
+        Result.Memory = (char *)Memory;
+        Result.Reserved = Reserved;
+        Result.Commit = CommitPages;
+    }
+    Result.Flags = arena_flag_FailHard;
+    Result.Name = Name;
+    Result.Overflow = ReportArenaOverflow;
+    return Result;
+}
+
+static void ReleaseArena(struct memory_arena *Arena)
+{
+    if (Arena->Reserved)
+    {
+        munmap(Arena->Memory, Arena->Reserved);
+    }
+    Arena->Memory = 0;
+    Arena->Size = Arena->Allocated = Arena->Reserved = 0;
+}
+
+static inline void PrintArenaStats(struct memory_arena *Arena)
+{
+    printf("%s: %zu / %zu (%f), high water %zu, %zu pushes",
+           Arena->Name ? Arena->Name : "(unnamed)", Arena->Allocated, Arena->Size,
+           Arena->Size ? (float)Arena->Allocated / (float)Arena->Size : 0.0f,
+           Arena->HighWater, Arena->PushCount);
+    if (Arena->Reserved)
+    {
+        printf(", %zu reserved", Arena->Reserved);
+    }
+    printf("\n");
+}
+
+static inline uint64_t GetNanoseconds(void)
+{
+    struct timespec Time;
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+    return (uint64_t)Time.tv_sec*1000000000ull + Time.tv_nsec;
+}
+
+#if NYT_PROFILE
+static void PrintProfile(char Json, uint64_t Nanoseconds, uint64_t Cycles)
+{
+    double CyclesPerNanosecond = Nanoseconds ? (double)Cycles / (double)Nanoseconds : 0.0;
+    if (Json)
+    {
+        printf("{\"elapsed_ns\":%llu,\"cycles\":%llu,\"blocks\":[", (unsigned long long)Nanoseconds, (unsigned long long)Cycles);
+        for (int Block = 0; Block < profile_block_Count; ++Block)
+        {
+            struct profile_anchor *Anchor = ProfileTotals.Blocks + Block;
+            printf("%s{\"name\":\"%s\",\"hits\":%llu,\"cycles\":%llu,\"ns\":%.0f,\"arena_bytes\":%llu}",
+                   Block ? "," : "", ProfileBlockNames[Block], (unsigned long long)Anchor->Hits, (unsigned long long)Anchor->Cycles,
+                   CyclesPerNanosecond ? Anchor->Cycles / CyclesPerNanosecond : 0.0, (unsigned long long)Anchor->ArenaBytes);
+        }
+        printf("],\"counters\":{");
+        for (int Counter = 0; Counter < profile_counter_Count; ++Counter)
+        {
+            printf("%s\"%s\":%llu", Counter ? "," : "", ProfileCounterNames[Counter], (unsigned long long)ProfileTotals.Counters[Counter]);
+        }
+        printf("}}\n");
+    }
+    else
+    {
+        printf("Profile: %.3f ms, %llu cycles (%.2f GHz)\n", Nanoseconds / 1e6, (unsigned long long)Cycles, CyclesPerNanosecond);
+        printf("%-20s %10s %14s %7s %10s %12s\n", "block", "hits", "cycles", "%", "ms", "arena bytes");
+        for (int Block = 0; Block < profile_block_Count; ++Block)
+        {
+            struct profile_anchor *Anchor = ProfileTotals.Blocks + Block;
+            if (Anchor->Hits)
+            {
+                printf("%-20s %10llu %14llu %6.2f%% %10.3f %12llu\n",
+                       ProfileBlockNames[Block], (unsigned long long)Anchor->Hits, (unsigned long long)Anchor->Cycles,
+                       Cycles ? 100.0*Anchor->Cycles / Cycles : 0.0,
+                       CyclesPerNanosecond ? Anchor->Cycles / CyclesPerNanosecond / 1e6 : 0.0, (unsigned long long)Anchor->ArenaBytes);
+            }
+        }
+        for (int Counter = 0; Counter < profile_counter_Count; ++Counter)
+        {
+            if (ProfileTotals.Counters[Counter])
+            {
+                printf("%-24s %14llu\n", ProfileCounterNames[Counter], (unsigned long long)ProfileTotals.Counters[Counter]);
+            }
+        }
+        uint64_t FindChildCalls = ProfileTotals.Counters[profile_counter_TrieFindChildCalls];
+        if (FindChildCalls)
+        {
+            printf("%-24s %14.2f\n", "sibling_steps_per_find", (double)ProfileTotals.Counters[profile_counter_TrieSiblingSteps] / FindChildCalls);
+        }
+    }
+}
+#endif
+
+static void *BuildTrieShardProc(void *Parameter)
+{
+    BuildTrie((struct trie_builder *)Parameter);
+    PROFILE_FLUSH();
+    return 0;
+}
+
+static struct trie_builder BuildTrieParallel(struct memory_arena *Arena, char *Lexicon, size_t Size, int ThreadCount)
+{
+    if (ThreadCount <= 0)
+    {
+        ThreadCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    struct lexicon_reader Readers[TRIE_MAX_SHARDS];
+    int ShardCount = SplitLexicon(Lexicon, Size, Readers, ThreadCount < TRIE_MAX_SHARDS ? ThreadCount : TRIE_MAX_SHARDS);
+    if (ShardCount < 2)
+    {
+        return BuildTrieFromLexicon(Arena, Lexicon, Size);
+    }
+
+    struct trie_builder Shards[TRIE_MAX_SHARDS];
+    pthread_t Threads[TRIE_MAX_SHARDS];
+    for (int ShardIndex = 0; ShardIndex < ShardCount; ++ShardIndex)
+    {
+        struct trie_builder *Shard = Shards + ShardIndex;
+        memset(Shard, 0, sizeof(*Shard));
+        Shard->Reader = Readers[ShardIndex];
+        Shard->Arena = ReserveArena(TRIE_BUILDER_ARENA_SIZE, "trie shard");
+        pthread_create(Threads + ShardIndex, 0, BuildTrieShardProc, Shard);
+    }
+    for (int ShardIndex = 0; ShardIndex < ShardCount; ++ShardIndex)
+    {
+        pthread_join(Threads[ShardIndex], 0);
+    }
+
+    struct trie_builder Result = StitchTrieShards(Arena, Shards, ShardCount);
+    for (int ShardIndex = 0; ShardIndex < ShardCount; ++ShardIndex)
+    {
+        ReleaseArena(&Shards[ShardIndex].Arena);
+    }
+    return Result;
+}
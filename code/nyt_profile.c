@@ -0,0 +1,137 @@
+#ifndef NYT_PROFILE
+#define NYT_PROFILE 0
+#endif
+
+enum profile_block
+{
+    profile_block_LoadDictionary,
+    profile_block_BuildTrie,
+    profile_block_BuildDawg,
+    profile_block_BuildBeeIndex,
+    profile_block_BuildBeePuzzleTable,
+    profile_block_SolveStrandsCell,
+    profile_block_DeduplicateSolutions,
+    profile_block_Combine,
+    profile_block_CombineMemoized,
+    profile_block_ExactCover,
+    profile_block_SolveSpellingBee,
+
+    profile_block_Count,
+};
+
+enum profile_counter
+{
+    profile_counter_SolveCalls,
+    profile_counter_TrieFindChildCalls,
+    profile_counter_TrieNodesTouched,
+    profile_counter_TrieSiblingSteps,
+    profile_counter_DawgFindChildCalls,
+    profile_counter_CombineCalls,
+    profile_counter_ExactCoverCalls,
+    profile_counter_SpellingBeeCalls,
+    profile_counter_ArenaPushes,
+    profile_counter_ArenaBytes,
+
+    profile_counter_Count,
+};
+
+struct profile_anchor
+{
+    uint64_t Hits;
+    uint64_t Cycles;
+    uint64_t ArenaBytes;
+};
+
+struct profile_table
+{
+    struct profile_anchor Blocks[profile_block_Count];
+    uint64_t Counters[profile_counter_Count];
+};
+
+static inline uint64_t ReadCycleCounter(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    uint64_t Result;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(Result));
+    return Result;
+#else
+    return 0;
+#endif
+}
+
+#if NYT_PROFILE
+
+static char *ProfileBlockNames[] =
+{
+    "load_dictionary",
+    "build_trie",
+    "build_dawg",
+    "build_bee_index",
+    "build_bee_puzzle_table",
+    "solve_strands_cell",
+    "deduplicate",
+    "combine",
+    "combine_memo",
+    "exact_cover",
+    "solve_spelling_bee",
+};
+
+static char *ProfileCounterNames[] =
+{
+    "solve_calls",
+    "trie_find_child_calls",
+    "trie_nodes_touched",
+    "trie_sibling_steps",
+    "dawg_find_child_calls",
+    "combine_calls",
+    "exact_cover_calls",
+    "spelling_bee_calls",
+    "arena_pushes",
+    "arena_bytes",
+};
+
+static _Thread_local struct profile_table ProfileThread;
+static struct profile_table ProfileTotals;
+
+static inline void EndProfileBlock(enum profile_block Block, uint64_t StartCycles, uint64_t StartBytes)
+{
+    struct profile_anchor *Anchor = ProfileThread.Blocks + Block;
+    Anchor->Hits++;
+    Anchor->Cycles += ReadCycleCounter() - StartCycles;
+    Anchor->ArenaBytes += ProfileThread.Counters[profile_counter_ArenaBytes] - StartBytes;
+}
+
+static void FlushProfile(void)
+{
+    for (int Block = 0; Block < profile_block_Count; ++Block)
+    {
+        struct profile_anchor *Source = ProfileThread.Blocks + Block;
+        struct profile_anchor *Dest = ProfileTotals.Blocks + Block;
+        __atomic_fetch_add(&Dest->Hits, Source->Hits, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&Dest->Cycles, Source->Cycles, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&Dest->ArenaBytes, Source->ArenaBytes, __ATOMIC_RELAXED);
+    }
+    for (int Counter = 0; Counter < profile_counter_Count; ++Counter)
+    {
+        __atomic_fetch_add(ProfileTotals.Counters + Counter, ProfileThread.Counters[Counter], __ATOMIC_RELAXED);
+    }
+    ProfileThread = (struct profile_table){0};
+}
+
+#define PROFILE_COUNT(Counter, Amount) (ProfileThread.Counters[profile_counter_##Counter] += (Amount))
+#define PROFILE_BLOCK_BEGIN(Block) \
+    uint64_t ProfileCycles_##Block = ReadCycleCounter(); \
+    uint64_t ProfileBytes_##Block = ProfileThread.Counters[profile_counter_ArenaBytes]
+#define PROFILE_BLOCK_END(Block) EndProfileBlock(profile_block_##Block, ProfileCycles_##Block, ProfileBytes_##Block)
+#define PROFILE_FLUSH() FlushProfile()
+
+#else
+
+#define PROFILE_COUNT(Counter, Amount)
+#define PROFILE_BLOCK_BEGIN(Block)
+#define PROFILE_BLOCK_END(Block)
+#define PROFILE_FLUSH()
+
+#endif
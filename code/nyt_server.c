@@ -0,0 +1,504 @@
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#define SERVER_DEFAULT_PORT 4747
+#define SERVER_REQUEST_SIZE 4096
+#define SERVER_MAX_CONNECTIONS 256
+#define SERVER_SEND_TIMEOUT_SECONDS 5
+#define SERVER_BACKOFF_MICROSECONDS 10000
+
+enum connection_state
+{
+    connection_state_Free,
+    connection_state_Idle,
+    connection_state_Busy,
+};
+
+struct server_connection
+{
+    int Socket;
+    enum connection_state State;
+    size_t Used;
+    char *Request;
+};
+
+struct server
+{
+    struct batch_job Strands;
+    struct batch_job SpellingBee;
+    struct server_connection Connections[SERVER_MAX_CONNECTIONS];
+    int Queue[SERVER_MAX_CONNECTIONS];
+    int QueueFirst;
+    int QueueCount;
+    pthread_mutex_t QueueLock;
+    pthread_cond_t QueueReady;
+    int WakePipe[2];
+};
+
+struct server_worker
+{
+    pthread_t Thread;
+    struct server *Server;
+    struct memory_arena Arena;
+    struct solution_builder Builder;
+    struct batch_record Record;
+};
+
+static int WriteAll(int Socket, char *Memory, size_t Size)
+{
+    while (Size)
+    {
+        ssize_t Written = send(Socket, Memory, Size, MSG_NOSIGNAL);
+        if (Written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (Written <= 0)
+        {
+            return 0;
+        }
+        Memory += Written;
+        Size -= Written;
+    }
+    return 1;
+}
+
+static char *SkipWord(char *At, char *End)
+{
+    while (At < End && *At != ' ' && *At != '\t')
+    {
+        At++;
+    }
+    while (At < End && (*At == ' ' || *At == '\t'))
+    {
+        At++;
+    }
+    return At;
+}
+
+static int IsCommand(char *Command, int Length, char *Name)
+{
+    return (Length == 1 && *Command == *Name) || (Length == (int)strlen(Name) && 0 == strncmp(Command, Name, Length));
+}
+
+static int HandleRequest(struct server_worker *Worker, char *Line, char *End, struct batch_record *Record)
+{
+    struct server *Server = Worker->Server;
+    char *Letters = SkipWord(Line, End);
+    *End = 0;
+
+    struct batch_puzzle Puzzle;
+    Puzzle.Name = Letters;
+    Puzzle.Contents = Letters;
+    Puzzle.Size = End - Letters;
+
+    BeginRecord(Record);
+    struct temporary_memory Temporary = BeginTemporaryMemory(&Worker->Arena);
+    int CommandLength = 0;
+    while (Line + CommandLength < Letters && Line[CommandLength] != ' ' && Line[CommandLength] != '\t')
+    {
+        CommandLength++;
+    }
+    if (IsCommand(Line, CommandLength, "strands") && Puzzle.Size)
+    {
+        SolveBatchStrands(&Worker->Arena, &Worker->Builder, &Server->Strands, &Puzzle, Record);
+    }
+    else if (IsCommand(Line, CommandLength, "bee") && Puzzle.Size)
+    {
+        SolveBatchSpellingBee(&Worker->Arena, &Server->SpellingBee, &Puzzle, Record);
+    }
+    else if (IsCommand(Line, CommandLength, "quit") && !Puzzle.Size)
+    {
+        EndTemporaryMemory(Temporary);
+        return 0;
+    }
+    else
+    {
+        RecordAppend(Record, "%.*s\terror\texpected \"s <board>\", \"b <letters>\" or \"q\"\n", CommandLength, Line);
+    }
+    EndRecord(Record, Puzzle.Name);
+    EndTemporaryMemory(Temporary);
+    return 1;
+}
+
+static void QueueConnection(struct server *Server, int ConnectionIndex)
+{
+    Server->Connections[ConnectionIndex].State = connection_state_Busy;
+    Server->Queue[(Server->QueueFirst + Server->QueueCount++) % SERVER_MAX_CONNECTIONS] = ConnectionIndex;
+    pthread_cond_signal(&Server->QueueReady);
+}
+
+static void CloseConnection(struct server *Server, struct server_connection *Connection)
+{
+    close(Connection->Socket);
+    pthread_mutex_lock(&Server->QueueLock);
+    Connection->State = connection_state_Free;
+    pthread_mutex_unlock(&Server->QueueLock);
+}
+
+static int HandleNextRequest(struct server_worker *Worker, struct server_connection *Connection)
+{
+    int Open = 1;
+    char *Line = Connection->Request;
+    char *LineEnd = memchr(Line, '\n', Connection->Used);
+    char *End = LineEnd;
+    while (Line < End && (End[-1] == '\r' || End[-1] == ' '))
+    {
+        End--;
+    }
+    if (Line < End)
+    {
+        Open = HandleRequest(Worker, Line, End, &Worker->Record) && WriteAll(Connection->Socket, Worker->Record.Memory, Worker->Record.Used);
+    }
+    Connection->Used -= LineEnd + 1 - Line;
+    memmove(Line, LineEnd + 1, Connection->Used);
+    return Open;
+}
+
+static void *ServerWorkerProc(void *Parameter)
+{
+    struct server_worker *Worker = (struct server_worker *)Parameter;
+    struct server *Server = Worker->Server;
+    Worker->Record.Size = BATCH_RECORD_SIZE;
+    Worker->Record.Memory = PushArray(&Worker->Arena, Worker->Record.Size, char);
+    for (;;)
+    {
+        pthread_mutex_lock(&Server->QueueLock);
+        while (!Server->QueueCount)
+        {
+            pthread_cond_wait(&Server->QueueReady, &Server->QueueLock);
+        }
+        int ConnectionIndex = Server->Queue[Server->QueueFirst];
+        Server->QueueFirst = (Server->QueueFirst + 1) % SERVER_MAX_CONNECTIONS;
+        Server->QueueCount--;
+        pthread_mutex_unlock(&Server->QueueLock);
+
+        struct server_connection *Connection = Server->Connections + ConnectionIndex;
+        if (!HandleNextRequest(Worker, Connection))
+        {
+            CloseConnection(Server, Connection);
+            continue;
+        }
+
+        char Pending = memchr(Connection->Request, '\n', Connection->Used) != 0;
+        pthread_mutex_lock(&Server->QueueLock);
+        if (Pending)
+        {
+            QueueConnection(Server, ConnectionIndex);
+        }
+        else
+        {
+            Connection->State = connection_state_Idle;
+        }
+        pthread_mutex_unlock(&Server->QueueLock);
+        if (!Pending)
+        {
+            char Wake = 0;
+            write(Server->WakePipe[1], &Wake, 1);
+        }
+    }
+    return 0;
+}
+
+static void ReadConnection(struct server *Server, int ConnectionIndex)
+{
+    struct server_connection *Connection = Server->Connections + ConnectionIndex;
+    ssize_t Received = recv(Connection->Socket, Connection->Request + Connection->Used, SERVER_REQUEST_SIZE - Connection->Used, 0);
+    if (Received < 0 && (errno == EINTR || errno == EAGAIN))
+    {
+        return;
+    }
+    if (Received <= 0)
+    {
+        CloseConnection(Server, Connection);
+        return;
+    }
+    Connection->Used += Received;
+    if (memchr(Connection->Request, '\n', Connection->Used))
+    {
+        pthread_mutex_lock(&Server->QueueLock);
+        QueueConnection(Server, ConnectionIndex);
+        pthread_mutex_unlock(&Server->QueueLock);
+    }
+    else if (Connection->Used == SERVER_REQUEST_SIZE)
+    {
+        char Error[] = "error\trequest too long\n";
+        WriteAll(Connection->Socket, Error, sizeof(Error) - 1);
+        CloseConnection(Server, Connection);
+    }
+}
+
+static int AcceptConnection(struct server *Server, int ListenSocket, int *SpareFile)
+{
+    int Socket = accept(ListenSocket, 0, 0);
+    if (Socket < 0)
+    {
+        if (errno == EMFILE || errno == ENFILE)
+        {
+            if (0 <= *SpareFile)
+            {
+                close(*SpareFile);
+                Socket = accept(ListenSocket, 0, 0);
+                if (0 <= Socket)
+                {
+                    close(Socket);
+                }
+                *SpareFile = open("/dev/null", O_RDONLY);
+            }
+            else
+            {
+                usleep(SERVER_BACKOFF_MICROSECONDS);
+                *SpareFile = open("/dev/null", O_RDONLY);
+            }
+            return 1;
+        }
+        return errno == EINTR || errno == ECONNABORTED || errno == EAGAIN;
+    }
+
+    int ConnectionIndex = -1;
+    pthread_mutex_lock(&Server->QueueLock);
+    for (int Index = 0; ConnectionIndex < 0 && Index < SERVER_MAX_CONNECTIONS; ++Index)
+    {
+        if (Server->Connections[Index].State == connection_state_Free)
+        {
+            ConnectionIndex = Index;
+        }
+    }
+    pthread_mutex_unlock(&Server->QueueLock);
+    if (ConnectionIndex < 0)
+    {
+        char Error[] = "error\tserver busy\n";
+        WriteAll(Socket, Error, sizeof(Error) - 1);
+        close(Socket);
+        return 1;
+    }
+
+    struct timeval Timeout = {SERVER_SEND_TIMEOUT_SECONDS, 0};
+    setsockopt(Socket, SOL_SOCKET, SO_SNDTIMEO, &Timeout, sizeof(Timeout));
+    struct server_connection *Connection = Server->Connections + ConnectionIndex;
+    Connection->Socket = Socket;
+    Connection->Used = 0;
+    Connection->State = connection_state_Idle;
+    return 1;
+}
+
+static int OpenListenSocket(char *SocketPath, int Port)
+{
+    int Result = -1;
+    if (SocketPath)
+    {
+        struct sockaddr_un Address = {0};
+        Address.sun_family = AF_UNIX;
+        if (strlen(SocketPath) < sizeof(Address.sun_path))
+        {
+            strcpy(Address.sun_path, SocketPath);
+            unlink(SocketPath);
+            Result = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (0 <= Result && bind(Result, (struct sockaddr *)&Address, sizeof(Address)) < 0)
+            {
+                close(Result);
+                Result = -1;
+            }
+        }
+    }
+    else
+    {
+        struct sockaddr_in Address = {0};
+        Address.sin_family = AF_INET;
+        Address.sin_port = htons(Port);
+        Address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        Result = socket(AF_INET, SOCK_STREAM, 0);
+        int Reuse = 1;
+        if (0 <= Result &&
+            (setsockopt(Result, SOL_SOCKET, SO_REUSEADDR, &Reuse, sizeof(Reuse)) < 0 ||
+             bind(Result, (struct sockaddr *)&Address, sizeof(Address)) < 0))
+        {
+            close(Result);
+            Result = -1;
+        }
+    }
+    if (0 <= Result && listen(Result, SOMAXCONN) < 0)
+    {
+        close(Result);
+        Result = -1;
+    }
+    return Result;
+}
+
+static int RunServer(struct memory_arena *Arena, struct packed_assets_header *Assets, char *ExecutableName, int ArgCount, char **Args)
+{
+    char *SocketPath = 0;
+    int Port = SERVER_DEFAULT_PORT;
+    int ThreadCount = 0;
+    size_t CacheMegabytes = RESULT_CACHE_DEFAULT_MEGABYTES;
+    char *CacheDirectory = 0;
+    enum dictionary_kind DictionaryKind = dictionary_kind_Dawg;
+    for (int ArgIndex = 2; ArgIndex < ArgCount; ++ArgIndex)
+    {
+        char *Arg = Args[ArgIndex];
+        char *Value = ++ArgIndex < ArgCount ? Args[ArgIndex] : 0;
+        if (0 == strcmp("-d", Arg) || 0 == strcmp("--dictionary", Arg))
+        {
+            if (!ParseDictionaryKind(Value, &DictionaryKind))
+            {
+                return 1;
+            }
+        }
+        else if (0 == strcmp("-j", Arg) || 0 == strcmp("--jobs", Arg))
+        {
+            if (!ParseThreadCount(Value, &ThreadCount))
+            {
+                return 1;
+            }
+        }
+        else if (0 == strcmp("-c", Arg) || 0 == strcmp("--cache-size", Arg))
+        {
+            if (!ParseCacheSize(Value, &CacheMegabytes))
+            {
+                return 1;
+            }
+        }
+        else if (Value && (0 == strcmp("-C", Arg) || 0 == strcmp("--cache-dir", Arg)))
+        {
+            CacheDirectory = Value;
+        }
+        else if (Value && (0 == strcmp("-u", Arg) || 0 == strcmp("--unix", Arg)))
+        {
+            SocketPath = Value;
+        }
+        else if (Value && (0 == strcmp("-p", Arg) || 0 == strcmp("--port", Arg)) && 0 < atoi(Value) && atoi(Value) < 65536)
+        {
+            Port = atoi(Value);
+        }
+        else
+        {
+            printf("usage: %s serve [-d trie|dawg] [-j N] [-c MB] [-C cache dir] [-u socket path | -p port]\n", ExecutableName);
+            return 1;
+        }
+    }
+    if (!ThreadCount)
+    {
+        ParseThreadCount("0", &ThreadCount);
+    }
+
+    int ListenSocket = OpenListenSocket(SocketPath, Port);
+    if (ListenSocket < 0)
+    {
+        if (SocketPath)
+        {
+            printf("Failed to listen on %s: %s\n", SocketPath, strerror(errno));
+        }
+        else
+        {
+            printf("Failed to listen on 127.0.0.1:%d: %s\n", Port, strerror(errno));
+        }
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    struct server *Server = PushStruct(Arena, server);
+    memset(Server, 0, sizeof(*Server));
+    struct dictionary *Dictionary = PushStruct(Arena, dictionary);
+    struct bee_index *BeeIndex = PushStruct(Arena, bee_index);
+    *Dictionary = LoadDictionary(Arena, Assets, DictionaryKind);
+    *BeeIndex = LoadBeeIndex(Arena, Assets);
+    Server->Strands.Game = nyt_game_Strands;
+    Server->Strands.Dictionary = Dictionary;
+    Server->SpellingBee.Game = nyt_game_SpellingBee;
+    Server->SpellingBee.BeeIndex = BeeIndex;
+    Server->SpellingBee.ShowPangrams = 1;
+    Server->Strands.Cache = Server->SpellingBee.Cache = CreateResultCache(Arena, Assets, CacheMegabytes, CacheDirectory);
+    pthread_mutex_init(&Server->QueueLock, 0);
+    pthread_cond_init(&Server->QueueReady, 0);
+    if (pipe(Server->WakePipe) < 0)
+    {
+        printf("Failed to create wake pipe: %s\n", strerror(errno));
+        return 1;
+    }
+    fcntl(Server->WakePipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(Server->WakePipe[1], F_SETFL, O_NONBLOCK);
+    for (int ConnectionIndex = 0; ConnectionIndex < SERVER_MAX_CONNECTIONS; ++ConnectionIndex)
+    {
+        Server->Connections[ConnectionIndex].Request = PushArray(Arena, SERVER_REQUEST_SIZE, char);
+    }
+
+    struct server_worker *Workers = PushArray(Arena, ThreadCount, struct server_worker);
+    for (int WorkerIndex = 0; WorkerIndex < ThreadCount; ++WorkerIndex)
+    {
+        struct server_worker *Worker = Workers + WorkerIndex;
+        memset(Worker, 0, sizeof(*Worker));
+        Worker->Server = Server;
+        Worker->Arena = ReserveArena(BATCH_WORKER_ARENA_SIZE, "connection");
+        Worker->Builder.StringArena = ReserveArena(BATCH_WORKER_ARENA_SIZE, "connection strings");
+        Worker->Builder.SolutionArena = ReserveArena(BATCH_WORKER_ARENA_SIZE, "connection solutions");
+        pthread_create(&Worker->Thread, 0, ServerWorkerProc, Worker);
+    }
+
+    if (SocketPath)
+    {
+        fprintf(stderr, "Listening on %s with %d workers\n", SocketPath, ThreadCount);
+    }
+    else
+    {
+        fprintf(stderr, "Listening on 127.0.0.1:%d with %d workers\n", Port, ThreadCount);
+    }
+
+    int SpareFile = open("/dev/null", O_RDONLY);
+    struct pollfd *Polls = PushArray(Arena, SERVER_MAX_CONNECTIONS + 2, struct pollfd);
+    int *PollConnections = PushArray(Arena, SERVER_MAX_CONNECTIONS + 2, int);
+    for (;;)
+    {
+        int PollCount = 0;
+        Polls[PollCount].fd = ListenSocket;
+        Polls[PollCount++].events = POLLIN;
+        Polls[PollCount].fd = Server->WakePipe[0];
+        Polls[PollCount++].events = POLLIN;
+        pthread_mutex_lock(&Server->QueueLock);
+        for (int ConnectionIndex = 0; ConnectionIndex < SERVER_MAX_CONNECTIONS; ++ConnectionIndex)
+        {
+            if (Server->Connections[ConnectionIndex].State == connection_state_Idle)
+            {
+                PollConnections[PollCount] = ConnectionIndex;
+                Polls[PollCount].fd = Server->Connections[ConnectionIndex].Socket;
+                Polls[PollCount++].events = POLLIN;
+            }
+        }
+        pthread_mutex_unlock(&Server->QueueLock);
+
+        if (poll(Polls, PollCount, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            printf("poll failed: %s\n", strerror(errno));
+            return 1;
+        }
+        if (Polls[1].revents)
+        {
+            char Wake[64];
+            while (0 < read(Server->WakePipe[0], Wake, sizeof(Wake)))
+            {
+            }
+        }
+        for (int PollIndex = 2; PollIndex < PollCount; ++PollIndex)
+        {
+            if (Polls[PollIndex].revents)
+            {
+                ReadConnection(Server, PollConnections[PollIndex]);
+            }
+        }
+        if (Polls[0].revents && !AcceptConnection(Server, ListenSocket, &SpareFile))
+        {
+            printf("accept failed: %s\n", strerror(errno));
+            return 1;
+        }
+    }
+    return 0;
+}
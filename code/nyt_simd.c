@@ -0,0 +1,276 @@
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#elif defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#define SIMD_LABEL_PADDING 32
+#define SIMD_LAST_LABEL 0x80
+#define SIMD_LABEL_BITS 0x7F
+
+enum simd_level
+{
+    simd_level_Unknown,
+    simd_level_Scalar,
+    simd_level_Sse2,
+    simd_level_Avx2,
+    simd_level_Simd128,
+};
+
+static enum simd_level SimdLevel;
+
+static enum simd_level GetSimdLevel(void)
+{
+    if (!SimdLevel)
+    {
+#if defined(__wasm_simd128__)
+        SimdLevel = simd_level_Simd128;
+#elif defined(__x86_64__)
+        __builtin_cpu_init();
+        SimdLevel = __builtin_cpu_supports("avx2") ? simd_level_Avx2 : simd_level_Sse2;
+#else
+        SimdLevel = simd_level_Scalar;
+#endif
+    }
+    return SimdLevel;
+}
+
+static char *FindLineEndScalar(char *At, char *End)
+{
+    while (At < End && *At && *At != '\n')
+    {
+        At++;
+    }
+    return At;
+}
+
+static int UpperCaseWordScalar(char *Dest, char *Source, int Length)
+{
+    int Result = 1;
+    for (int CharIndex = 0; CharIndex < Length; ++CharIndex)
+    {
+        char Char = Source[CharIndex];
+        if ('a' <= Char && Char <= 'z')
+        {
+            Char = 'A' + (Char - 'a');
+        }
+        Result &= 'A' <= Char && Char <= 'Z';
+        Dest[CharIndex] = Char;
+    }
+    return Result;
+}
+
+static int FindChildLabelScalar(uint8_t *Labels, char Char)
+{
+    for (int Index = 0;; ++Index)
+    {
+        if ((Labels[Index] & SIMD_LABEL_BITS) == (uint8_t)Char)
+        {
+            return Index;
+        }
+        if (Labels[Index] & SIMD_LAST_LABEL)
+        {
+            return -1;
+        }
+    }
+}
+
+static inline int MatchChildLabels(uint32_t Matches, uint32_t Lasts, int Base, int *Result)
+{
+    if (Lasts)
+    {
+        Matches &= Lasts ^ (Lasts - 1);
+    }
+    *Result = Matches ? Base + __builtin_ctz(Matches) : -1;
+    return Matches || Lasts;
+}
+
+#if defined(__x86_64__)
+static char *FindLineEndSse2(char *At, char *End)
+{
+    __m128i Newline = _mm_set1_epi8('\n');
+    __m128i Zero = _mm_setzero_si128();
+    for (; 16 <= End - At; At += 16)
+    {
+        __m128i Chars = _mm_loadu_si128((__m128i *)At);
+        uint32_t Hits = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(Chars, Newline), _mm_cmpeq_epi8(Chars, Zero)));
+        if (Hits)
+        {
+            return At + __builtin_ctz(Hits);
+        }
+    }
+    return FindLineEndScalar(At, End);
+}
+
+__attribute__((target("avx2")))
+static char *FindLineEndAvx2(char *At, char *End)
+{
+    __m256i Newline = _mm256_set1_epi8('\n');
+    __m256i Zero = _mm256_setzero_si256();
+    for (; 32 <= End - At; At += 32)
+    {
+        __m256i Chars = _mm256_loadu_si256((__m256i *)At);
+        uint32_t Hits = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(Chars, Newline), _mm256_cmpeq_epi8(Chars, Zero)));
+        if (Hits)
+        {
+            return At + __builtin_ctz(Hits);
+        }
+    }
+    return FindLineEndSse2(At, End);
+}
+
+static int UpperCaseWordSse2(char *Dest, char *Source, int Length)
+{
+    __m128i LowerA = _mm_set1_epi8('a' - 128);
+    __m128i LowerRange = _mm_set1_epi8(-128 + 25);
+    __m128i UpperA = _mm_set1_epi8('A' - 128);
+    __m128i CaseBit = _mm_set1_epi8(0x20);
+    __m128i NotLetters = _mm_setzero_si128();
+    int CharIndex = 0;
+    for (; CharIndex + 16 <= Length; CharIndex += 16)
+    {
+        __m128i Chars = _mm_loadu_si128((__m128i *)(Source + CharIndex));
+        __m128i NotLower = _mm_cmpgt_epi8(_mm_sub_epi8(Chars, LowerA), LowerRange);
+        Chars = _mm_sub_epi8(Chars, _mm_andnot_si128(NotLower, CaseBit));
+        NotLetters = _mm_or_si128(NotLetters, _mm_cmpgt_epi8(_mm_sub_epi8(Chars, UpperA), LowerRange));
+        _mm_storeu_si128((__m128i *)(Dest + CharIndex), Chars);
+    }
+    int Result = UpperCaseWordScalar(Dest + CharIndex, Source + CharIndex, Length - CharIndex);
+    return Result && !_mm_movemask_epi8(NotLetters);
+}
+
+static int FindChildLabelSse2(uint8_t *Labels, char Char)
+{
+    __m128i Target = _mm_set1_epi8(Char);
+    __m128i LabelBits = _mm_set1_epi8(SIMD_LABEL_BITS);
+    int Result;
+    for (int Base = 0;; Base += 16)
+    {
+        __m128i Chars = _mm_loadu_si128((__m128i *)(Labels + Base));
+        uint32_t Lasts = _mm_movemask_epi8(Chars);
+        uint32_t Matches = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(Chars, LabelBits), Target));
+        if (MatchChildLabels(Matches, Lasts, Base, &Result))
+        {
+            return Result;
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static int FindChildLabelAvx2(uint8_t *Labels, char Char)
+{
+    __m256i Target = _mm256_set1_epi8(Char);
+    __m256i LabelBits = _mm256_set1_epi8(SIMD_LABEL_BITS);
+    int Result;
+    for (int Base = 0;; Base += 32)
+    {
+        __m256i Chars = _mm256_loadu_si256((__m256i *)(Labels + Base));
+        uint32_t Lasts = _mm256_movemask_epi8(Chars);
+        uint32_t Matches = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(Chars, LabelBits), Target));
+        if (MatchChildLabels(Matches, Lasts, Base, &Result))
+        {
+            return Result;
+        }
+    }
+}
+#endif
+
+#if defined(__wasm_simd128__)
+static char *FindLineEndSimd128(char *At, char *End)
+{
+    v128_t Newline = wasm_i8x16_splat('\n');
+    v128_t Zero = wasm_i8x16_splat(0);
+    for (; 16 <= End - At; At += 16)
+    {
+        v128_t Chars = wasm_v128_load(At);
+        uint32_t Hits = wasm_i8x16_bitmask(wasm_v128_or(wasm_i8x16_eq(Chars, Newline), wasm_i8x16_eq(Chars, Zero)));
+        if (Hits)
+        {
+            return At + __builtin_ctz(Hits);
+        }
+    }
+    return FindLineEndScalar(At, End);
+}
+
+static int UpperCaseWordSimd128(char *Dest, char *Source, int Length)
+{
+    v128_t LowerA = wasm_i8x16_splat('a');
+    v128_t UpperA = wasm_i8x16_splat('A');
+    v128_t LetterCount = wasm_i8x16_splat(26);
+    v128_t CaseBit = wasm_i8x16_splat(0x20);
+    v128_t NotLetters = wasm_i8x16_splat(0);
+    int CharIndex = 0;
+    for (; CharIndex + 16 <= Length; CharIndex += 16)
+    {
+        v128_t Chars = wasm_v128_load(Source + CharIndex);
+        v128_t IsLower = wasm_u8x16_lt(wasm_i8x16_sub(Chars, LowerA), LetterCount);
+        Chars = wasm_i8x16_sub(Chars, wasm_v128_and(IsLower, CaseBit));
+        NotLetters = wasm_v128_or(NotLetters, wasm_u8x16_ge(wasm_i8x16_sub(Chars, UpperA), LetterCount));
+        wasm_v128_store(Dest + CharIndex, Chars);
+    }
+    int Result = UpperCaseWordScalar(Dest + CharIndex, Source + CharIndex, Length - CharIndex);
+    return Result && !wasm_v128_any_true(NotLetters);
+}
+
+static int FindChildLabelSimd128(uint8_t *Labels, char Char)
+{
+    v128_t Target = wasm_i8x16_splat(Char);
+    v128_t LabelBits = wasm_i8x16_splat(SIMD_LABEL_BITS);
+    int Result;
+    for (int Base = 0;; Base += 16)
+    {
+        v128_t Chars = wasm_v128_load(Labels + Base);
+        uint32_t Lasts = wasm_i8x16_bitmask(Chars);
+        uint32_t Matches = wasm_i8x16_bitmask(wasm_i8x16_eq(wasm_v128_and(Chars, LabelBits), Target));
+        if (MatchChildLabels(Matches, Lasts, Base, &Result))
+        {
+            return Result;
+        }
+    }
+}
+#endif
+
+static char *FindLineEnd(char *At, char *End)
+{
+    switch (GetSimdLevel())
+    {
+#if defined(__x86_64__)
+        case simd_level_Avx2: return FindLineEndAvx2(At, End);
+        case simd_level_Sse2: return FindLineEndSse2(At, End);
+#endif
+#if defined(__wasm_simd128__)
+        case simd_level_Simd128: return FindLineEndSimd128(At, End);
+#endif
+        default: return FindLineEndScalar(At, End);
+    }
+}
+
+static int UpperCaseWord(char *Dest, char *Source, int Length)
+{
+    switch (GetSimdLevel())
+    {
+#if defined(__x86_64__)
+        case simd_level_Avx2:
+        case simd_level_Sse2: return UpperCaseWordSse2(Dest, Source, Length);
+#endif
+#if defined(__wasm_simd128__)
+        case simd_level_Simd128: return UpperCaseWordSimd128(Dest, Source, Length);
+#endif
+        default: return UpperCaseWordScalar(Dest, Source, Length);
+    }
+}
+
+static inline int FindChildLabel(uint8_t *Labels, char Char)
+{
+    switch (SimdLevel)
+    {
+#if defined(__x86_64__)
+        case simd_level_Avx2: return FindChildLabelAvx2(Labels, Char);
+        case simd_level_Sse2: return FindChildLabelSse2(Labels, Char);
+#endif
+#if defined(__wasm_simd128__)
+        case simd_level_Simd128: return FindChildLabelSimd128(Labels, Char);
+#endif
+        default: return FindChildLabelScalar(Labels, Char);
+    }
+}
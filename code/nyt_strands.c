@@ -0,0 +1,658 @@
+#define STRANDS_PASTE_(A, B) A##B
+#define STRANDS_PASTE(A, B) STRANDS_PASTE_(A, B)
+#define STRANDS_NAME(Name) STRANDS_PASTE(Name, STRANDS_SUFFIX)
+
+#define MaskZero STRANDS_PASTE(MaskZero, STRANDS_MASK_SUFFIX)
+#define MaskCell STRANDS_PASTE(MaskCell, STRANDS_MASK_SUFFIX)
+#define MaskOr STRANDS_PASTE(MaskOr, STRANDS_MASK_SUFFIX)
+#define MaskAndNot STRANDS_PASTE(MaskAndNot, STRANDS_MASK_SUFFIX)
+#define MaskIntersects STRANDS_PASTE(MaskIntersects, STRANDS_MASK_SUFFIX)
+#define MaskEquals STRANDS_PASTE(MaskEquals, STRANDS_MASK_SUFFIX)
+#define MaskAny STRANDS_PASTE(MaskAny, STRANDS_MASK_SUFFIX)
+#define MaskCount STRANDS_PASTE(MaskCount, STRANDS_MASK_SUFFIX)
+#define MaskFirst STRANDS_PASTE(MaskFirst, STRANDS_MASK_SUFFIX)
+#define MaskRest STRANDS_PASTE(MaskRest, STRANDS_MASK_SUFFIX)
+#define MaskHash STRANDS_PASTE(MaskHash, STRANDS_MASK_SUFFIX)
+#define SolutionMask STRANDS_PASTE(SolutionMask, STRANDS_MASK_SUFFIX)
+#define StoreSolutionMask STRANDS_PASTE(StoreSolutionMask, STRANDS_MASK_SUFFIX)
+#define MemoMask STRANDS_PASTE(MemoMask, STRANDS_MASK_SUFFIX)
+#define StoreMemoMask STRANDS_PASTE(StoreMemoMask, STRANDS_MASK_SUFFIX)
+
+static void STRANDS_NAME(BuildKnownDistances)(struct strands_puzzle *Puzzle)
+{
+    STRANDS_GEOMETRY *Geometry = STRANDS_GEOMETRY_OF(Puzzle);
+    STRANDS_MASK Reached = MaskAndNot(Geometry->FullMask, Geometry->UnknownMask);
+    for (int CellIndex = 0; CellIndex < Puzzle->CellCount; ++CellIndex)
+    {
+        Puzzle->KnownDistances[CellIndex] = MaskIntersects(Reached, MaskCell(CellIndex)) ? 0 : 0xFF;
+    }
+    for (int Distance = 1; Distance < 0xFF; ++Distance)
+    {
+        STRANDS_MASK Next = Reached;
+        for (STRANDS_MASK Unreached = MaskAndNot(Geometry->FullMask, Reached); MaskAny(Unreached); Unreached = MaskRest(Unreached))
+        {
+            int CellIndex = MaskFirst(Unreached);
+            if (MaskIntersects(Geometry->NeighborMasks[CellIndex], Reached))
+            {
+                Puzzle->KnownDistances[CellIndex] = (uint8_t)Distance;
+                Next = MaskOr(Next, MaskCell(CellIndex));
+            }
+        }
+        if (MaskEquals(Next, Reached))
+        {
+            break;
+        }
+        Reached = Next;
+    }
+}
+
+static void STRANDS_NAME(BuildBoardGeometry)(struct strands_puzzle *Puzzle)
+{
+    STRANDS_GEOMETRY *Geometry = STRANDS_GEOMETRY_OF(Puzzle);
+    Geometry->FullMask = MaskZero();
+    for (int Edge = 0; Edge < 4; ++Edge)
+    {
+        Geometry->EdgeMasks[Edge] = MaskZero();
+    }
+    for (int Letter = 0; Letter < 26; ++Letter)
+    {
+        Geometry->LetterMasks[Letter] = MaskZero();
+    }
+    Geometry->UnknownMask = MaskZero();
+    char Blocked = Puzzle->Unknown == unknown_cells_Blocked;
+    for (int RowIndex = 0; RowIndex < Puzzle->Height; ++RowIndex)
+    {
+        for (int ColIndex = 0; ColIndex < Puzzle->Width; ++ColIndex)
+        {
+            int CellIndex = RowIndex*Puzzle->Width + ColIndex;
+            STRANDS_MASK Cell = MaskCell(CellIndex);
+            STRANDS_MASK Neighbors = MaskZero();
+            Geometry->NeighborMasks[CellIndex] = Neighbors;
+            if (Puzzle->Letters[CellIndex] == UNKNOWN_CELL)
+            {
+                if (Blocked)
+                {
+                    continue;
+                }
+                if (Puzzle->Unknown == unknown_cells_Wildcard)
+                {
+                    Geometry->UnknownMask = MaskOr(Geometry->UnknownMask, Cell);
+                }
+            }
+            for (int RowOffset = -1; RowOffset <= 1; ++RowOffset)
+            {
+                for (int ColOffset = -1; ColOffset <= 1; ++ColOffset)
+                {
+                    int Row = RowIndex + RowOffset;
+                    int Col = ColIndex + ColOffset;
+                    if ((RowOffset || ColOffset) &&
+                        0 <= Row && Row < Puzzle->Height &&
+                        0 <= Col && Col < Puzzle->Width &&
+                        !(Blocked && Puzzle->Letters[Row*Puzzle->Width + Col] == UNKNOWN_CELL))
+                    {
+                        Neighbors = MaskOr(Neighbors, MaskCell(Row*Puzzle->Width + Col));
+                    }
+                }
+            }
+            Geometry->NeighborMasks[CellIndex] = Neighbors;
+            Geometry->FullMask = MaskOr(Geometry->FullMask, Cell);
+            if (RowIndex == 0)
+            {
+                Geometry->EdgeMasks[board_edge_Top] = MaskOr(Geometry->EdgeMasks[board_edge_Top], Cell);
+            }
+            if (RowIndex == Puzzle->Height - 1)
+            {
+                Geometry->EdgeMasks[board_edge_Bottom] = MaskOr(Geometry->EdgeMasks[board_edge_Bottom], Cell);
+            }
+            if (ColIndex == 0)
+            {
+                Geometry->EdgeMasks[board_edge_Left] = MaskOr(Geometry->EdgeMasks[board_edge_Left], Cell);
+            }
+            if (ColIndex == Puzzle->Width - 1)
+            {
+                Geometry->EdgeMasks[board_edge_Right] = MaskOr(Geometry->EdgeMasks[board_edge_Right], Cell);
+            }
+            uint32_t Letter = (uint32_t)(Puzzle->Letters[CellIndex] - 'A');
+            if (Letter < 26)
+            {
+                Geometry->LetterMasks[Letter] = MaskOr(Geometry->LetterMasks[Letter], Cell);
+            }
+        }
+    }
+    if (Puzzle->Unknown == unknown_cells_Wildcard)
+    {
+        STRANDS_NAME(BuildKnownDistances)(Puzzle);
+    }
+}
+
+static inline char STRANDS_NAME(CanCompleteWord)(struct strands_puzzle *Puzzle, STRANDS_MASK Visited, uint32_t Summary)
+{
+    STRANDS_MASK Unvisited = MaskAndNot(STRANDS_FULL_MASK(Puzzle), Visited);
+    char Result = NodeSummaryLength(Summary) <= (uint32_t)MaskCount(Unvisited);
+    for (uint32_t Letters = Summary & NODE_SUMMARY_LETTER_BITS; Result && Letters; Letters &= Letters - 1)
+    {
+        Result = MaskIntersects(STRANDS_GEOMETRY_OF(Puzzle)->LetterMasks[__builtin_ctz(Letters)], Unvisited);
+    }
+    return Result;
+}
+
+void STRANDS_NAME(Solve)(struct strands_puzzle *Puzzle, int CellIndex, STRANDS_MASK Visited, char *Buffer, int Length, struct dictionary *Dictionary, dictionary_node Node, struct solution_builder *Builder)
+{
+    char Char = Puzzle->Letters[CellIndex];
+    dictionary_node Child = DictionaryFindChild(Dictionary, Node, Char);
+    Builder->NodesVisited++;
+    PROFILE_COUNT(SolveCalls, 1);
+    if (Child)
+    {
+        Visited = MaskOr(Visited, MaskCell(CellIndex));
+        Buffer[Length++] = Char;
+        if (Length >= MIN_LENGTH && DictionaryTerminal(Dictionary, Child))
+        {
+            struct solution *Solution = PushStruct(&Builder->SolutionArena, solution);
+            Solution->Length = Length;
+            Solution->Word = ArenaPush(&Builder->StringArena, Length);
+            Copy(Solution->Word, Buffer, Length);
+            StoreSolutionMask(&Builder->StringArena, Solution, Visited);
+            Builder->SolutionCount++;
+        }
+        STRANDS_MASK Neighbors = MaskAndNot(STRANDS_GEOMETRY_OF(Puzzle)->NeighborMasks[CellIndex], Visited);
+        if (MaskAny(Neighbors) && Dictionary->Summaries && !STRANDS_NAME(CanCompleteWord)(Puzzle, Visited, Dictionary->Summaries[Child]))
+        {
+            Builder->NodesPruned++;
+            Neighbors = MaskZero();
+        }
+        for (; MaskAny(Neighbors); Neighbors = MaskRest(Neighbors))
+        {
+            STRANDS_NAME(Solve)(Puzzle, MaskFirst(Neighbors), Visited, Buffer, Length, Dictionary, Child, Builder);
+        }
+    }
+}
+
+static inline char STRANDS_NAME(CanCompletePartialWord)(struct strands_puzzle *Puzzle, STRANDS_MASK Visited, int Wildcards, uint32_t Summary)
+{
+    STRANDS_GEOMETRY *Geometry = STRANDS_GEOMETRY_OF(Puzzle);
+    STRANDS_MASK Unvisited = MaskAndNot(STRANDS_FULL_MASK(Puzzle), Visited);
+    int KnownCount = MaskCount(MaskAndNot(Unvisited, Geometry->UnknownMask));
+    int UnknownCount = MaskCount(Unvisited) - KnownCount;
+    int Free = Wildcards < UnknownCount ? Wildcards : UnknownCount;
+    char Result = NodeSummaryLength(Summary) <= (uint32_t)(KnownCount + Free);
+    for (uint32_t Letters = Summary & NODE_SUMMARY_LETTER_BITS; Result && Letters; Letters &= Letters - 1)
+    {
+        if (!MaskIntersects(Geometry->LetterMasks[__builtin_ctz(Letters)], Unvisited))
+        {
+            Result = 0 <= --Free;
+        }
+    }
+    return Result;
+}
+
+void STRANDS_NAME(SolvePartial)(struct strands_puzzle *Puzzle, int CellIndex, STRANDS_MASK Visited, char *Buffer, int Length, int Wildcards, char Anchored, struct dictionary *Dictionary, dictionary_node Node, struct solution_builder *Builder)
+{
+    STRANDS_MASK Cell = MaskCell(CellIndex);
+    char Wildcard = MaskIntersects(STRANDS_GEOMETRY_OF(Puzzle)->UnknownMask, Cell);
+    PROFILE_COUNT(SolveCalls, 1);
+    char Known = Puzzle->Letters[CellIndex];
+    uint32_t Letters = 'A' <= Known && Known <= 'Z' ? 1u << (Known - 'A') : 0;
+    if (Wildcard)
+    {
+        if (!Anchored ? Wildcards < Puzzle->KnownDistances[CellIndex] : !Wildcards)
+        {
+            return;
+        }
+        Wildcards--;
+        Letters = DictionaryChildLetters(Dictionary, Node);
+    }
+    else
+    {
+        Anchored = 1;
+    }
+    Visited = MaskOr(Visited, Cell);
+    STRANDS_MASK Unvisited = MaskAndNot(STRANDS_GEOMETRY_OF(Puzzle)->NeighborMasks[CellIndex], Visited);
+    for (; Letters; Letters &= Letters - 1)
+    {
+        char Char = 'A' + __builtin_ctz(Letters);
+        dictionary_node Child = DictionaryFindChild(Dictionary, Node, Char);
+        Builder->NodesVisited++;
+        if (Child)
+        {
+            Buffer[Length] = Wildcard ? Char - 'A' + 'a' : Char;
+            if (Anchored && Length + 1 >= MIN_LENGTH && DictionaryTerminal(Dictionary, Child))
+            {
+                struct solution *Solution = PushStruct(&Builder->SolutionArena, solution);
+                Solution->Length = Length + 1;
+                Solution->Word = ArenaPush(&Builder->StringArena, Length + 1);
+                Copy(Solution->Word, Buffer, Length + 1);
+                StoreSolutionMask(&Builder->StringArena, Solution, Visited);
+                Builder->SolutionCount++;
+            }
+            STRANDS_MASK Neighbors = Unvisited;
+            if (MaskAny(Neighbors) && Dictionary->Summaries && !STRANDS_NAME(CanCompletePartialWord)(Puzzle, Visited, Wildcards, Dictionary->Summaries[Child]))
+            {
+                Builder->NodesPruned++;
+                Neighbors = MaskZero();
+            }
+            for (; MaskAny(Neighbors); Neighbors = MaskRest(Neighbors))
+            {
+                STRANDS_NAME(SolvePartial)(Puzzle, MaskFirst(Neighbors), Visited, Buffer, Length + 1, Wildcards, Anchored, Dictionary, Child, Builder);
+            }
+        }
+    }
+}
+
+static void STRANDS_NAME(SolveStrandsCell)(struct strands_puzzle *Puzzle, int CellIndex, struct dictionary *Dictionary, struct solution_builder *Builder)
+{
+    char Buffer[256];
+    if (Puzzle->Unknown == unknown_cells_Wildcard)
+    {
+        STRANDS_NAME(SolvePartial)(Puzzle, CellIndex, MaskZero(), Buffer, 0, Puzzle->MaxWildcards, 0, Dictionary, 0, Builder);
+    }
+    else
+    {
+        STRANDS_NAME(Solve)(Puzzle, CellIndex, MaskZero(), Buffer, 0, Dictionary, 0, Builder);
+    }
+}
+
+static uint32_t STRANDS_NAME(HashSolution)(struct solution *Solution)
+{
+    uint32_t Hash = 2166136261u;
+    for (int CharIndex = 0; CharIndex < Solution->Length; ++CharIndex)
+    {
+        Hash = (Hash ^ (uint8_t)Solution->Word[CharIndex]) * 16777619u;
+    }
+    return MaskHash(Hash, SolutionMask(Solution));
+}
+
+static char STRANDS_NAME(SolutionEquals)(struct solution *A, struct solution *B)
+{
+    char Result = MaskEquals(SolutionMask(A), SolutionMask(B)) && A->Length == B->Length;
+    for (int CharIndex = 0; Result && CharIndex < A->Length; ++CharIndex)
+    {
+        Result = A->Word[CharIndex] == B->Word[CharIndex];
+    }
+    return Result;
+}
+
+static void STRANDS_NAME(DeduplicateSolutions)(struct solution_builder *Builder, struct memory_arena *TempArena)
+{
+    size_t TableSize = 1;
+    while (TableSize < 2*Builder->SolutionCount)
+    {
+        TableSize <<= 1;
+    }
+    struct temporary_memory Temporary = BeginTemporaryMemory(TempArena);
+    int32_t *Table = PushArray(TempArena, TableSize, int32_t);
+    for (size_t SlotIndex = 0; SlotIndex < TableSize; ++SlotIndex)
+    {
+        Table[SlotIndex] = -1;
+    }
+
+    struct solution *Solutions = (struct solution *)Builder->SolutionArena.Memory;
+    size_t UniqueCount = 0;
+    for (size_t SolutionIndex = 0; SolutionIndex < Builder->SolutionCount; ++SolutionIndex)
+    {
+        struct solution *Solution = Solutions + SolutionIndex;
+        size_t SlotIndex = STRANDS_NAME(HashSolution)(Solution) & (TableSize - 1);
+        while (Table[SlotIndex] >= 0 && !STRANDS_NAME(SolutionEquals)(Solutions + Table[SlotIndex], Solution))
+        {
+            SlotIndex = (SlotIndex + 1) & (TableSize - 1);
+        }
+        if (Table[SlotIndex] < 0)
+        {
+            Table[SlotIndex] = (int32_t)UniqueCount;
+            Solutions[UniqueCount++] = *Solution;
+        }
+    }
+    Builder->SolutionCount = UniqueCount;
+    Builder->SolutionArena.Allocated = UniqueCount*sizeof(struct solution);
+    EndTemporaryMemory(Temporary);
+}
+
+static void STRANDS_NAME(Combine_)(struct strands_puzzle *Puzzle, struct combiner *Combiner, int StartIndex, STRANDS_MASK Mask)
+{
+    struct combination *Combination = &Combiner->Combination;
+    struct solution *Solutions = Combiner->Solutions;
+    Combiner->NodesVisited++;
+    PROFILE_COUNT(CombineCalls, 1);
+    if (Combiner->Mode == combine_mode_Full)
+    {
+        for (STRANDS_MASK Uncovered = MaskAndNot(STRANDS_FULL_MASK(Puzzle), Mask); MaskAny(Uncovered); Uncovered = MaskRest(Uncovered))
+        {
+            if (Combiner->LastCoveringIndex[MaskFirst(Uncovered)] < StartIndex)
+            {
+                return;
+            }
+        }
+    }
+
+    char Extended = 0;
+    for (size_t NextIndex = StartIndex; NextIndex < Combiner->SolutionCount; ++NextIndex)
+    {
+        STRANDS_MASK SolutionCells = SolutionMask(Solutions + NextIndex);
+        if (!MaskIntersects(Mask, SolutionCells))
+        {
+            Extended = 1;
+            Combination->Indices[Combination->Count++] = (int)NextIndex;
+            STRANDS_NAME(Combine_)(Puzzle, Combiner, (int)NextIndex + 1, MaskOr(Mask, SolutionCells));
+            --Combination->Count;
+        }
+    }
+
+    char Emit = 1;
+    if (Combiner->Mode == combine_mode_Full)
+    {
+        Emit = MaskEquals(Mask, STRANDS_FULL_MASK(Puzzle));
+    }
+    else if (Combiner->Mode == combine_mode_Maximal)
+    {
+        Emit = !Extended;
+        for (int PreviousIndex = 0; Emit && PreviousIndex < StartIndex; ++PreviousIndex)
+        {
+            Emit = MaskIntersects(Mask, SolutionMask(Solutions + PreviousIndex));
+        }
+    }
+    if (Emit)
+    {
+        Combiner->CombinationCount++;
+        Combiner->Callback(Combiner->Context, Solutions, Combination->Indices, Combination->Count);
+    }
+}
+
+static size_t STRANDS_NAME(Combine)(struct strands_puzzle *Puzzle, struct solution_builder *Builder, enum combine_mode Mode, combination_callback *Callback, void *Context)
+{
+    struct combiner Combiner = {0};
+    Combiner.Solutions = (struct solution *)Builder->SolutionArena.Memory;
+    Combiner.SolutionCount = Builder->SolutionCount;
+    Combiner.Mode = Mode;
+    Combiner.Callback = Callback;
+    Combiner.Context = Context;
+    for (int CellIndex = 0; CellIndex < STRANDS_CELL_COUNT(Puzzle); ++CellIndex)
+    {
+        Combiner.LastCoveringIndex[CellIndex] = -1;
+    }
+    for (size_t SolutionIndex = 0; SolutionIndex < Combiner.SolutionCount; ++SolutionIndex)
+    {
+        for (STRANDS_MASK Cells = SolutionMask(Combiner.Solutions + SolutionIndex); MaskAny(Cells); Cells = MaskRest(Cells))
+        {
+            Combiner.LastCoveringIndex[MaskFirst(Cells)] = (int)SolutionIndex;
+        }
+    }
+    STRANDS_NAME(Combine_)(Puzzle, &Combiner, 0, MaskZero());
+    Builder->CombineNodesVisited += Combiner.NodesVisited;
+    return Combiner.CombinationCount;
+}
+
+static struct combine_memo *STRANDS_NAME(FindCombineMemo)(struct combine_memo_table *Table, STRANDS_MASK Decided)
+{
+    size_t SlotIndex = MaskHash(2166136261u, Decided) & Table->SlotMask;
+    struct combine_memo *Memo = Table->Slots + SlotIndex;
+    while (0 <= Memo->Covered && !MaskEquals(MemoMask(Memo), Decided))
+    {
+        SlotIndex = (SlotIndex + 1) & Table->SlotMask;
+        Memo = Table->Slots + SlotIndex;
+    }
+    return Memo;
+}
+
+static void STRANDS_NAME(ResizeCombineMemo)(struct combine_memo_table *Table, size_t SlotCount)
+{
+    struct combine_memo *OldSlots = Table->Slots;
+    size_t OldSlotCount = OldSlots ? Table->SlotMask + 1 : 0;
+    Table->SlotMask = SlotCount - 1;
+    Table->Slots = PushArray(Table->Arena, SlotCount, struct combine_memo);
+    for (size_t SlotIndex = 0; SlotIndex < SlotCount; ++SlotIndex)
+    {
+        Table->Slots[SlotIndex].Covered = -1;
+    }
+    for (size_t SlotIndex = 0; SlotIndex < OldSlotCount; ++SlotIndex)
+    {
+        if (0 <= OldSlots[SlotIndex].Covered)
+        {
+            *STRANDS_NAME(FindCombineMemo)(Table, MemoMask(OldSlots + SlotIndex)) = OldSlots[SlotIndex];
+        }
+    }
+}
+
+static struct combine_memo STRANDS_NAME(CombineMemoized_)(struct strands_puzzle *Puzzle, struct combine_memo_table *Table, STRANDS_MASK Decided)
+{
+    Table->Lookups++;
+    PROFILE_COUNT(CombineCalls, 1);
+    struct combine_memo *Memo = STRANDS_NAME(FindCombineMemo)(Table, Decided);
+    if (0 <= Memo->Covered)
+    {
+        Table->Hits++;
+        return *Memo;
+    }
+
+    struct combine_memo Result;
+    Table->NodesVisited++;
+    STRANDS_MASK Undecided = MaskAndNot(STRANDS_FULL_MASK(Puzzle), Decided);
+    if (!MaskAny(Undecided))
+    {
+        Result.Covered = 0;
+        Result.TilingCount = 1;
+    }
+    else
+    {
+        int CellIndex = MaskFirst(Undecided);
+        Result = STRANDS_NAME(CombineMemoized_)(Puzzle, Table, MaskOr(Decided, MaskCell(CellIndex)));
+        Result.TilingCount = 0;
+        for (int At = Table->CellFirst[CellIndex]; At < Table->CellFirst[CellIndex + 1]; ++At)
+        {
+            struct solution *Solution = Table->Solutions + Table->CellSolutions[At];
+            STRANDS_MASK Cells = SolutionMask(Solution);
+            if (!MaskIntersects(Cells, Decided))
+            {
+                struct combine_memo Child = STRANDS_NAME(CombineMemoized_)(Puzzle, Table, MaskOr(Decided, Cells));
+                Result.TilingCount += Child.TilingCount;
+                if (Result.Covered < Child.Covered + Solution->Length)
+                {
+                    Result.Covered = Child.Covered + Solution->Length;
+                }
+            }
+        }
+    }
+
+    if (3*(Table->SlotMask + 1) < 4*(Table->EntryCount + 1))
+    {
+        STRANDS_NAME(ResizeCombineMemo)(Table, 2*(Table->SlotMask + 1));
+    }
+    Memo = STRANDS_NAME(FindCombineMemo)(Table, Decided);
+    Memo->Covered = Result.Covered;
+    Memo->TilingCount = Result.TilingCount;
+    StoreMemoMask(Table->Arena, Memo, Decided);
+    Table->EntryCount++;
+    return Result;
+}
+
+static uint64_t STRANDS_NAME(CombineMemoized)(struct memory_arena *TempArena, struct strands_puzzle *Puzzle, struct solution_builder *Builder, struct combine_summary *Summary)
+{
+    struct temporary_memory Temporary = BeginTemporaryMemory(TempArena);
+    struct combine_memo_table Table = {0};
+    Table.Arena = TempArena;
+    Table.Solutions = (struct solution *)Builder->SolutionArena.Memory;
+
+    int CellCount = STRANDS_CELL_COUNT(Puzzle);
+    int CellCounts[PUZZLE_MAX_CELLS];
+    for (int CellIndex = 0; CellIndex < CellCount; ++CellIndex)
+    {
+        CellCounts[CellIndex] = 0;
+    }
+    for (size_t SolutionIndex = 0; SolutionIndex < Builder->SolutionCount; ++SolutionIndex)
+    {
+        CellCounts[MaskFirst(SolutionMask(Table.Solutions + SolutionIndex))]++;
+    }
+    for (int CellIndex = 0; CellIndex < CellCount; ++CellIndex)
+    {
+        Table.CellFirst[CellIndex + 1] = Table.CellFirst[CellIndex] + CellCounts[CellIndex];
+        CellCounts[CellIndex] = Table.CellFirst[CellIndex];
+    }
+    Table.CellSolutions = PushArray(TempArena, Builder->SolutionCount, int);
+    for (size_t SolutionIndex = 0; SolutionIndex < Builder->SolutionCount; ++SolutionIndex)
+    {
+        Table.CellSolutions[CellCounts[MaskFirst(SolutionMask(Table.Solutions + SolutionIndex))]++] = (int)SolutionIndex;
+    }
+    STRANDS_NAME(ResizeCombineMemo)(&Table, 1024);
+
+    struct combine_memo Root = STRANDS_NAME(CombineMemoized_)(Puzzle, &Table, MaskZero());
+    Summary->BestCovered = Root.Covered;
+    Summary->TilingCount = Root.TilingCount;
+    Summary->MemoStates = Table.EntryCount;
+    Summary->Best.Count = 0;
+
+    STRANDS_MASK Decided = MaskZero();
+    int Covered = Root.Covered;
+    while (Covered)
+    {
+        int CellIndex = MaskFirst(MaskAndNot(STRANDS_FULL_MASK(Puzzle), Decided));
+        STRANDS_MASK Next = MaskOr(Decided, MaskCell(CellIndex));
+        for (int At = Table.CellFirst[CellIndex]; At < Table.CellFirst[CellIndex + 1]; ++At)
+        {
+            struct solution *Solution = Table.Solutions + Table.CellSolutions[At];
+            STRANDS_MASK Cells = SolutionMask(Solution);
+            if (!MaskIntersects(Cells, Decided) &&
+                STRANDS_NAME(FindCombineMemo)(&Table, MaskOr(Decided, Cells))->Covered + Solution->Length == Covered)
+            {
+                Summary->Best.Indices[Summary->Best.Count++] = Table.CellSolutions[At];
+                Covered -= Solution->Length;
+                Next = MaskOr(Decided, Cells);
+                break;
+            }
+        }
+        Decided = Next;
+    }
+
+    Builder->CombineNodesVisited += Table.NodesVisited;
+    Builder->CombineMemoLookups += Table.Lookups;
+    Builder->CombineMemoHits += Table.Hits;
+    EndTemporaryMemory(Temporary);
+    return Root.TilingCount;
+}
+
+static inline char STRANDS_NAME(IsSpangram)(struct strands_puzzle *Puzzle, STRANDS_MASK Cells)
+{
+    STRANDS_GEOMETRY *Geometry = STRANDS_GEOMETRY_OF(Puzzle);
+    return ((MaskIntersects(Cells, Geometry->EdgeMasks[board_edge_Top]) && MaskIntersects(Cells, Geometry->EdgeMasks[board_edge_Bottom])) ||
+            (MaskIntersects(Cells, Geometry->EdgeMasks[board_edge_Left]) && MaskIntersects(Cells, Geometry->EdgeMasks[board_edge_Right])));
+}
+
+static inline char STRANDS_NAME(ExactCoverCandidate)(struct exact_cover *Cover, int SolutionIndex, STRANDS_MASK Mask, int SpangramCount)
+{
+    return (!MaskIntersects(SolutionMask(Cover->Solutions + SolutionIndex), Mask) &&
+            !(Cover->RequireSpangram && SpangramCount && Cover->Spangrams[SolutionIndex]));
+}
+
+static void STRANDS_NAME(ExactCover_)(struct strands_puzzle *Puzzle, struct exact_cover *Cover, STRANDS_MASK Mask, int SpangramCount)
+{
+    Cover->NodesVisited++;
+    PROFILE_COUNT(ExactCoverCalls, 1);
+    if (MaskEquals(Mask, STRANDS_FULL_MASK(Puzzle)))
+    {
+        if (!Cover->RequireSpangram || SpangramCount == 1)
+        {
+            Cover->CoverCount++;
+            Cover->Callback(Cover->Context, Cover->Solutions, Cover->Indices, Cover->Count);
+        }
+        return;
+    }
+
+    int BestCell = -1;
+    int BestCount = 0x7FFFFFFF;
+    for (STRANDS_MASK Uncovered = MaskAndNot(STRANDS_FULL_MASK(Puzzle), Mask); MaskAny(Uncovered) && BestCount; Uncovered = MaskRest(Uncovered))
+    {
+        int CellIndex = MaskFirst(Uncovered);
+        int CandidateCount = 0;
+        for (int At = Cover->CellFirst[CellIndex]; At < Cover->CellFirst[CellIndex + 1] && CandidateCount < BestCount; ++At)
+        {
+            CandidateCount += STRANDS_NAME(ExactCoverCandidate)(Cover, Cover->CellSolutions[At], Mask, SpangramCount);
+        }
+        if (CandidateCount < BestCount)
+        {
+            BestCount = CandidateCount;
+            BestCell = CellIndex;
+        }
+    }
+
+    if (BestCount && Cover->Count < MAX_WORDS)
+    {
+        for (int At = Cover->CellFirst[BestCell]; At < Cover->CellFirst[BestCell + 1]; ++At)
+        {
+            int SolutionIndex = Cover->CellSolutions[At];
+            if (STRANDS_NAME(ExactCoverCandidate)(Cover, SolutionIndex, Mask, SpangramCount))
+            {
+                Cover->Indices[Cover->Count++] = SolutionIndex;
+                STRANDS_NAME(ExactCover_)(Puzzle, Cover, MaskOr(Mask, SolutionMask(Cover->Solutions + SolutionIndex)), SpangramCount + Cover->Spangrams[SolutionIndex]);
+                --Cover->Count;
+            }
+        }
+    }
+}
+
+static size_t STRANDS_NAME(ExactCover)(struct memory_arena *TempArena, struct strands_puzzle *Puzzle, struct solution_builder *Builder, char RequireSpangram, combination_callback *Callback, void *Context)
+{
+    struct temporary_memory Temporary = BeginTemporaryMemory(TempArena);
+    struct exact_cover Cover = {0};
+    Cover.Solutions = (struct solution *)Builder->SolutionArena.Memory;
+    Cover.RequireSpangram = RequireSpangram;
+    Cover.Callback = Callback;
+    Cover.Context = Context;
+    Cover.Spangrams = PushArray(TempArena, Builder->SolutionCount, char);
+
+    int CellCount = STRANDS_CELL_COUNT(Puzzle);
+    int CellCounts[PUZZLE_MAX_CELLS];
+    for (int CellIndex = 0; CellIndex < CellCount; ++CellIndex)
+    {
+        CellCounts[CellIndex] = 0;
+    }
+    for (size_t SolutionIndex = 0; SolutionIndex < Builder->SolutionCount; ++SolutionIndex)
+    {
+        STRANDS_MASK Cells = SolutionMask(Cover.Solutions + SolutionIndex);
+        Cover.Spangrams[SolutionIndex] = STRANDS_NAME(IsSpangram)(Puzzle, Cells);
+        for (; MaskAny(Cells); Cells = MaskRest(Cells))
+        {
+            CellCounts[MaskFirst(Cells)]++;
+        }
+    }
+    for (int CellIndex = 0; CellIndex < CellCount; ++CellIndex)
+    {
+        Cover.CellFirst[CellIndex + 1] = Cover.CellFirst[CellIndex] + CellCounts[CellIndex];
+        CellCounts[CellIndex] = Cover.CellFirst[CellIndex];
+    }
+    Cover.CellSolutions = PushArray(TempArena, Cover.CellFirst[CellCount], int);
+    for (size_t SolutionIndex = 0; SolutionIndex < Builder->SolutionCount; ++SolutionIndex)
+    {
+        for (STRANDS_MASK Cells = SolutionMask(Cover.Solutions + SolutionIndex); MaskAny(Cells); Cells = MaskRest(Cells))
+        {
+            Cover.CellSolutions[CellCounts[MaskFirst(Cells)]++] = (int)SolutionIndex;
+        }
+    }
+
+    STRANDS_NAME(ExactCover_)(Puzzle, &Cover, MaskZero(), 0);
+    Builder->CombineNodesVisited += Cover.NodesVisited;
+    EndTemporaryMemory(Temporary);
+    return Cover.CoverCount;
+}
+
+#undef MaskZero
+#undef MaskCell
+#undef MaskOr
+#undef MaskAndNot
+#undef MaskIntersects
+#undef MaskEquals
+#undef MaskAny
+#undef MaskCount
+#undef MaskFirst
+#undef MaskRest
+#undef MaskHash
+#undef SolutionMask
+#undef StoreSolutionMask
+#undef MemoMask
+#undef StoreMemoMask
+
+#undef STRANDS_NAME
+#undef STRANDS_SUFFIX
+#undef STRANDS_MASK_SUFFIX
+#undef STRANDS_MASK
+#undef STRANDS_GEOMETRY
+#undef STRANDS_GEOMETRY_OF
+#undef STRANDS_FULL_MASK
+#undef STRANDS_CELL_COUNT
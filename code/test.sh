@@ -0,0 +1,42 @@
+#!/bin/sh
+# Regression checks for the packed build from code/build.sh; run from the repo root.
+NYT=${NYT:-../build/nyt}
+Failures=0
+Board=$(mktemp)
+trap 'rm -f "$Board"' EXIT
+
+expect() {
+    Expected=$1
+    shift
+    Actual=$("$NYT" "$@")
+    if [ "$Actual" != "$Expected" ]; then
+        printf 'FAIL: nyt %s\nexpected:\n%s\nactual:\n%s\n' "$*" "$Expected" "$Actual"
+        Failures=$((Failures + 1))
+    fi
+}
+
+# Known non-letter cells must never match a letter, whatever the unknown cell mode.
+printf 'TA#O\nZZZZ\n' > "$Board"
+for Mode in "-u literal" "-u blocked" "-u wildcard -w 0" "-u wildcard -w 2"; do
+    expect "$(printf 'Solutions: 0\nExact covers: 0')" strands $Mode -x "$Board"
+done
+
+# The wasm builds in docs/ must agree with the native solver, on a fixed board and a wide one.
+if command -v node > /dev/null; then
+    for File in data/strands_20250904.txt data/strands_wide.txt; do
+        Expected=$("$NYT" strands -x "$File")
+        for Jobs in 0 2; do
+            Actual=$(node docs/strands_node.js -j $Jobs -c 1000 "$File" 2>&1)
+            if [ "$Actual" != "$Expected" ]; then
+                printf 'FAIL: node docs/strands_node.js -j %s %s differs from nyt strands -x\n' "$Jobs" "$File"
+                Failures=$((Failures + 1))
+            fi
+        done
+    done
+fi
+
+if [ "$Failures" -ne 0 ]; then
+    echo "$Failures check(s) failed"
+    exit 1
+fi
+echo "All checks passed"
@@ -0,0 +1,132 @@
+const memorySize = 32*1024*1024;
+const databaseName = "nyt";
+const imageStoreName = "images";
+const sessionImageOffset = 0;
+const sessionImageSizeOffset = 4;
+const sessionBatchOffset = 8;
+const solutionSize = 6;
+
+function openDatabase() {
+    return new Promise((resolve, reject) => {
+        const request = indexedDB.open(databaseName, 1);
+        request.onupgradeneeded = () => request.result.createObjectStore(imageStoreName);
+        request.onsuccess = () => resolve(request.result);
+        request.onerror = () => reject(request.error);
+    });
+}
+async function readCachedImage(key) {
+    try {
+        const database = await openDatabase();
+        return await new Promise((resolve, reject) => {
+            const request = database.transaction(imageStoreName).objectStore(imageStoreName).get(key);
+            request.onsuccess = () => resolve(request.result);
+            request.onerror = () => reject(request.error);
+        });
+    } catch {
+        return undefined;
+    }
+}
+async function writeCachedImage(key, image) {
+    try {
+        const database = await openDatabase();
+        const transaction = database.transaction(imageStoreName, "readwrite");
+        const store = transaction.objectStore(imageStoreName);
+        store.clear();
+        store.put(image, key);
+    } catch {
+    }
+}
+function decodeN(dataView, cursor, length) {
+    let result = "";
+
+    while (length--)
+    {
+        result += String.fromCharCode(dataView.getUint8(cursor++));
+    }
+    return result;
+}
+async function createSession() {
+    const pages = memorySize / (64*1024);
+    const memory = new WebAssembly.Memory({ initial: pages, maximum: pages });
+    const { instance } = await WebAssembly.instantiateStreaming(fetch("bee.wasm"), {
+        env: {
+            memory,
+        },
+    });
+    const exports = instance.exports;
+    const heapBase = exports.__heap_base.value;
+    const session = exports.CreateSpellingBeeSession(heapBase, memorySize - heapBase);
+
+    const lexHead = await fetch("scrabble.lex", { method: "HEAD" });
+    const lexVersion = lexHead.headers.get("ETag") || lexHead.headers.get("Last-Modified");
+    const imageKey = "bee:" + lexVersion + ":" + lexHead.headers.get("Content-Length");
+    const cachedImage = lexVersion ? await readCachedImage(imageKey) : undefined;
+    let loaded = false;
+    if (cachedImage) {
+        const imagePointer = exports.PushSpellingBeeInput(session, cachedImage.byteLength);
+        new Uint8Array(memory.buffer, imagePointer, cachedImage.byteLength).set(new Uint8Array(cachedImage));
+        loaded = exports.LoadSpellingBeeImage(session, imagePointer, cachedImage.byteLength);
+    }
+    if (!loaded) {
+        const lexResponse = await fetch("scrabble.lex");
+        const lexImage = new Uint8Array(await lexResponse.arrayBuffer());
+        const lexPointer = exports.PushSpellingBeeInput(session, lexImage.length);
+        new Uint8Array(memory.buffer, lexPointer, lexImage.length).set(lexImage);
+        if (!exports.BuildSpellingBeeImage(session, lexPointer, lexImage.length)) {
+            throw new Error("scrabble.lex is not a lexicon image");
+        }
+        if (lexVersion) {
+            const dataView = new DataView(memory.buffer);
+            const image = dataView.getUint32(session + sessionImageOffset, true);
+            const imageSize = dataView.getUint32(session + sessionImageSizeOffset, true);
+            await writeCachedImage(imageKey, memory.buffer.slice(image, image + imageSize));
+        }
+    }
+    return { exports, memory, session };
+}
+
+const sessionPromise = createSession();
+let currentSolve = 0;
+
+async function solve(id, letters) {
+    const { exports, memory, session } = await sessionPromise;
+    const asciiA = "A".charCodeAt(0);
+    let letterMask = 0;
+    for (const letter of letters) {
+        letterMask |= 1 << (letter.charCodeAt(0) - asciiA);
+    }
+    if (!exports.BeginSpellingBeeSolve(session, letterMask, letters[0].charCodeAt(0) - asciiA)) {
+        postMessage({ type: "error", id, message: "expected seven distinct letters" });
+        return;
+    }
+    let solutionCount = 0;
+    let batchCount;
+    while (id === currentSolve && (batchCount = exports.StepSpellingBeeSolve(session))) {
+        const dataView = new DataView(memory.buffer);
+        const solutions = [];
+        let solution = session + sessionBatchOffset;
+        for (let solutionIndex = 0; solutionIndex < batchCount; ++solutionIndex) {
+            const solutionLength = dataView.getUint8(solution + 0);
+            const solutionWord = dataView.getUint32(solution + 1, true);
+            const solutionMask = dataView.getUint8(solution + 5);
+            solution += solutionSize;
+            solutions.push({ word: decodeN(dataView, solutionWord, solutionLength), mask: solutionMask });
+        }
+        solutionCount += batchCount;
+        postMessage({ type: "solutions", id, solutions });
+        await new Promise((resolve) => setTimeout(resolve, 0));
+    }
+    if (id === currentSolve) {
+        postMessage({ type: "done", id, solutionCount });
+    }
+}
+
+onmessage = (event) => {
+    const message = event.data;
+    if (message.type === "solve") {
+        currentSolve = message.id;
+        solve(message.id, message.letters).catch((error) => {
+            postMessage({ type: "error", id: message.id, message: String(error) });
+        });
+    }
+};
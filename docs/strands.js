@@ -0,0 +1,175 @@
+const sessionSolutionsOffset = 0;
+const sessionSolutionCountOffset = 4;
+const sessionCoversOffset = 8;
+const sessionCoverCountOffset = 12;
+const sessionTotalCoverCountOffset = 16;
+const sessionImageOffset = 20;
+const sessionImageSizeOffset = 24;
+const sessionBoardOffset = 28;
+const sessionWidthOffset = 32;
+const sessionHeightOffset = 36;
+const sessionBoardTextOffset = 40;
+const boardTextSize = 4*512;
+const solutionSize = 16;
+const solutionMaskOffset = 8;
+const combinationSize = 4 + 4*128;
+const cellMaskWords = 8;
+const strandsBoardWide = 2;
+const pageSize = 64*1024;
+
+function listen(worker, handler) {
+    if (worker.on) {
+        worker.on("message", handler);
+    } else {
+        worker.addEventListener("message", (event) => handler(event.data));
+    }
+}
+function request(worker, message) {
+    return new Promise((resolve, reject) => {
+        worker.pending = { resolve, reject };
+        worker.postMessage(message);
+    });
+}
+function decodeN(dataView, cursor, length) {
+    let result = "";
+
+    while (length--)
+    {
+        result += String.fromCharCode(dataView.getUint8(cursor++));
+    }
+    return result;
+}
+
+export async function createStrandsSolver({ module, lexicon, image, threadCount = 0, createWorker,
+                                            memorySize = 128*1024*1024, workerArenaSize = 4*1024*1024, workerStackSize = 256*1024 }) {
+    const pages = memorySize / pageSize;
+    const memory = new WebAssembly.Memory({ initial: pages, maximum: pages, shared: threadCount > 0 });
+    const instance = await WebAssembly.instantiate(module, {
+        env: {
+            memory,
+        },
+    });
+    const exports = instance.exports;
+    const heapBase = exports.__heap_base.value;
+    const session = exports.CreateStrandsSession(heapBase, memorySize - heapBase);
+
+    const stackTops = [];
+    for (let workerIndex = 0; workerIndex < threadCount; ++workerIndex) {
+        const stack = exports.PushStrandsInput(session, workerStackSize);
+        stackTops.push((stack + workerStackSize) & ~15);
+    }
+
+    let loaded = false;
+    if (image) {
+        const imagePointer = exports.PushStrandsInput(session, image.byteLength);
+        new Uint8Array(memory.buffer, imagePointer, image.byteLength).set(new Uint8Array(image));
+        loaded = exports.LoadStrandsImage(session, imagePointer, image.byteLength);
+    }
+    if (!loaded) {
+        const lexImage = new Uint8Array(lexicon);
+        const lexPointer = exports.PushStrandsInput(session, lexImage.length);
+        new Uint8Array(memory.buffer, lexPointer, lexImage.length).set(lexImage);
+        if (!exports.BuildStrandsImage(session, lexPointer, lexImage.length)) {
+            throw new Error("lexicon is not a lexicon image");
+        }
+    }
+
+    const workers = [];
+    for (let workerIndex = 0; workerIndex < threadCount; ++workerIndex) {
+        const worker = createWorker();
+        listen(worker, (message) => {
+            const pending = worker.pending;
+            worker.pending = undefined;
+            if (message.type === "error") {
+                pending.reject(new Error(message.message));
+            } else {
+                pending.resolve(message);
+            }
+        });
+        workers.push(worker);
+    }
+    await Promise.all(workers.map((worker, workerIndex) => request(worker, {
+        type: "init", module, memory, stackTop: stackTops[workerIndex],
+    })));
+
+    function readSolutions(dataView) {
+        const board = dataView.getInt32(session + sessionBoardOffset, true);
+        const solutionCount = dataView.getUint32(session + sessionSolutionCountOffset, true);
+        let solution = dataView.getUint32(session + sessionSolutionsOffset, true);
+        const solutions = [];
+        for (let solutionIndex = 0; solutionIndex < solutionCount; ++solutionIndex) {
+            const solutionLength = dataView.getUint8(solution + 0);
+            const solutionWord = dataView.getUint32(solution + 4, true);
+            let cells = 0n;
+            if (board === strandsBoardWide) {
+                const cellMask = dataView.getUint32(solution + solutionMaskOffset, true);
+                for (let wordIndex = cellMaskWords - 1; wordIndex >= 0; --wordIndex) {
+                    cells = (cells << 64n) | dataView.getBigUint64(cellMask + 8*wordIndex, true);
+                }
+            } else {
+                cells = dataView.getBigUint64(solution + solutionMaskOffset, true);
+            }
+            solution += solutionSize;
+            solutions.push({ word: decodeN(dataView, solutionWord, solutionLength), cells });
+        }
+        return solutions;
+    }
+    function readCovers(dataView) {
+        const coverCount = dataView.getUint32(session + sessionCoverCountOffset, true);
+        let cover = dataView.getUint32(session + sessionCoversOffset, true);
+        const covers = [];
+        for (let coverIndex = 0; coverIndex < coverCount; ++coverIndex) {
+            const indexCount = dataView.getInt32(cover, true);
+            const indices = [];
+            for (let indexIndex = 0; indexIndex < indexCount; ++indexIndex) {
+                indices.push(dataView.getInt32(cover + 4 + 4*indexIndex, true));
+            }
+            cover += combinationSize;
+            covers.push(indices);
+        }
+        return covers;
+    }
+
+    return {
+        image() {
+            const dataView = new DataView(memory.buffer);
+            const imagePointer = dataView.getUint32(session + sessionImageOffset, true);
+            const imageSize = dataView.getUint32(session + sessionImageSizeOffset, true);
+            return new Uint8Array(memory.buffer).slice(imagePointer, imagePointer + imageSize);
+        },
+        async solve(boardText, { requireSpangram = false, maxCovers = 16 } = {}) {
+            const boardBytes = new Uint8Array(memory.buffer, session + sessionBoardTextOffset, boardTextSize);
+            const boardSize = Math.min(boardText.length, boardTextSize);
+            for (let charIndex = 0; charIndex < boardSize; ++charIndex) {
+                boardBytes[charIndex] = boardText.charCodeAt(charIndex);
+            }
+            const workerCount = Math.max(threadCount, 1);
+            if (boardText.length > boardTextSize ||
+                !exports.BeginStrandsSolve(session, boardSize, workerCount, workerArenaSize)) {
+                throw new Error("expected rows of equal length, at most 512 cells");
+            }
+            if (threadCount) {
+                await Promise.all(workers.map((worker, workerIndex) => request(worker, {
+                    type: "run", session, workerIndex,
+                })));
+            } else {
+                exports.RunStrandsWorker(session, 0);
+            }
+            exports.FinishStrandsSolve(session, requireSpangram ? 1 : 0, maxCovers);
+
+            const dataView = new DataView(memory.buffer);
+            return {
+                width: dataView.getInt32(session + sessionWidthOffset, true),
+                height: dataView.getInt32(session + sessionHeightOffset, true),
+                solutions: readSolutions(dataView),
+                covers: readCovers(dataView),
+                coverCount: dataView.getUint32(session + sessionTotalCoverCountOffset, true),
+            };
+        },
+        terminate() {
+            for (const worker of workers) {
+                worker.terminate();
+            }
+        },
+    };
+}
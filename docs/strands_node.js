@@ -0,0 +1,59 @@
+import { readFile } from "node:fs/promises";
+import { Worker } from "node:worker_threads";
+import { createStrandsSolver } from "./strands.js";
+
+let threadCount = 0;
+let requireSpangram = false;
+let maxCovers = 16;
+let boardPath;
+const args = process.argv.slice(2);
+for (let argIndex = 0; argIndex < args.length; ++argIndex) {
+    const arg = args[argIndex];
+    if (arg === "-j" && argIndex + 1 < args.length) {
+        threadCount = Math.max(0, parseInt(args[++argIndex], 10) || 0);
+    } else if (arg === "-c" && argIndex + 1 < args.length) {
+        maxCovers = Math.max(0, parseInt(args[++argIndex], 10) || 0);
+    } else if (arg === "-s") {
+        requireSpangram = true;
+    } else if (!arg.startsWith("-") && !boardPath) {
+        boardPath = arg;
+    } else {
+        boardPath = undefined;
+        break;
+    }
+}
+if (!boardPath) {
+    console.log("usage: node docs/strands_node.js [-j threads] [-s] [-c max covers] <filename>");
+    process.exit(1);
+}
+
+const wasmName = threadCount ? "nyt_threads.wasm" : "bee.wasm";
+const module = await WebAssembly.compile(await readFile(new URL(wasmName, import.meta.url)));
+const lexicon = await readFile(new URL("scrabble.lex", import.meta.url));
+const solver = await createStrandsSolver({
+    module,
+    lexicon,
+    threadCount,
+    createWorker: () => new Worker(new URL("strands_worker.js", import.meta.url)),
+});
+try {
+    const result = await solver.solve(await readFile(boardPath, "latin1"), { requireSpangram, maxCovers });
+    const cellCount = result.width*result.height;
+    const lines = [`Solutions: ${result.solutions.length}`];
+    for (const solution of result.solutions) {
+        const cells = cellCount > 64
+            ? solution.cells.toString(16).padStart(16*Math.ceil(cellCount / 64), "0")
+            : solution.cells.toString();
+        lines.push(`${solution.word} (${cells})`);
+    }
+    for (const cover of result.covers) {
+        for (const index of cover) {
+            lines.push(result.solutions[index].word);
+        }
+        lines.push("====");
+    }
+    lines.push(`Exact covers: ${result.coverCount}`);
+    console.log(lines.join("\n"));
+} finally {
+    solver.terminate();
+}
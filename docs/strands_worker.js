@@ -0,0 +1,29 @@
+let exports;
+let port = globalThis.self;
+if (!port) {
+    const { parentPort } = await import("node:worker_threads");
+    port = parentPort;
+    port.on("message", handleMessage);
+} else {
+    port.onmessage = (event) => handleMessage(event.data);
+}
+
+function handleMessage(message) {
+    try {
+        if (message.type === "init") {
+            const instance = new WebAssembly.Instance(message.module, {
+                env: {
+                    memory: message.memory,
+                },
+            });
+            exports = instance.exports;
+            exports.__stack_pointer.value = message.stackTop;
+            port.postMessage({ type: "ready" });
+        } else if (message.type === "run") {
+            exports.RunStrandsWorker(message.session, message.workerIndex);
+            port.postMessage({ type: "done" });
+        }
+    } catch (error) {
+        port.postMessage({ type: "error", message: String(error) });
+    }
+}